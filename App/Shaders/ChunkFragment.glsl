@@ -5,9 +5,11 @@ in VS_OUT {
     vec2 uv;
     vec3 normal;
     float ao;
+    flat vec2 tile;
 } fs_in;
 
 uniform sampler2D u_Atlas;
+uniform vec2 u_TileSize;
 
 uniform vec3 u_SunDirection;
 uniform vec3 u_SunColor;
@@ -20,7 +22,10 @@ uniform float u_FogEnd;
 out vec4 FragColor;
 
 void main() {
-    vec4 textureColor = texture(u_Atlas, fs_in.uv);
+    // uv counts blocks across the face, repeat the atlas tile once per block
+    vec2 uv = fs_in.tile + fract(fs_in.uv) * u_TileSize;
+
+    vec4 textureColor = texture(u_Atlas, uv);
 
     if(textureColor.a < 0.1) {
         discard;
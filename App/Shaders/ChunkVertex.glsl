@@ -1,9 +1,7 @@
 #version 460 core
 
-layout (location = 0) in vec3 a_Position;
-layout (location = 1) in vec2 a_UV;
-layout (location = 2) in vec3 a_Normal;
-layout (location = 3) in float a_AO;
+// packed vertex, see Renderer::ChunkVertex
+layout (location = 0) in uvec2 a_Data;
 
 // layout (binding = 0) uniform Matrices {
 //     mat4 u_ViewProjection;
@@ -14,18 +12,41 @@ uniform mat4 u_Projection;
 uniform mat4 u_View;
 uniform mat4 u_Model;
 
+uniform vec2 u_TileSize;
+
 out VS_OUT {
     vec3 fragPos;
     vec2 uv;
     vec3 normal;
     float ao;
+    flat vec2 tile;
 } vs_out;
 
+// front, back, left, right, top, bottom
+const vec3 c_Normals[6] = vec3[6](
+    vec3( 0.0,  0.0,  1.0),
+    vec3( 0.0,  0.0, -1.0),
+    vec3(-1.0,  0.0,  0.0),
+    vec3( 1.0,  0.0,  0.0),
+    vec3( 0.0,  1.0,  0.0),
+    vec3( 0.0, -1.0,  0.0)
+);
+
 void main() {
-    vs_out.fragPos = (u_Model * vec4(a_Position, 1.0)).xyz;
-    vs_out.uv = a_UV;
-    vs_out.normal = a_Normal;
-    vs_out.ao = a_AO;
+    // block corners are packed, blocks are centered on whole numbers
+    vec3 position = vec3(a_Data.x & 31u, (a_Data.x >> 5) & 511u, (a_Data.x >> 14) & 31u) - 0.5;
+
+    uint normal = (a_Data.x >> 19) & 7u;
+    uint ao = (a_Data.x >> 22) & 3u;
+
+    uvec2 tile = uvec2(a_Data.y & 15u, (a_Data.y >> 4) & 15u);
+    vec2 uv = vec2((a_Data.y >> 8) & 31u, (a_Data.y >> 13) & 31u);
+
+    vs_out.fragPos = (u_Model * vec4(position, 1.0)).xyz;
+    vs_out.uv = uv;
+    vs_out.normal = c_Normals[normal];
+    vs_out.ao = float(ao);
+    vs_out.tile = vec2(tile) * u_TileSize;
 
-    gl_Position = u_Projection * u_View * u_Model * vec4(a_Position, 1.0);
+    gl_Position = u_Projection * u_View * u_Model * vec4(position, 1.0);
 }
@@ -13,14 +13,36 @@
 #include <numeric>
 #include <ranges>
 #include <algorithm>
+#include <chrono>
 
-AppLayer::AppLayer() {
+AppLayer::AppLayer(std::optional<uint32_t> seed) {
     // create chunk manager
-    m_ChunkManager = std::make_shared<ChunkManager>();
+    m_ChunkManager = std::make_shared<ChunkManager>(m_ViewDistance + s_ChunkRemoveDistance, seed);
 
     // allocate memory for chunks sorting
     m_ChunksSorted.reserve(m_ViewDistance * m_ViewDistance);
 
+    // chunks up to one diagonal step outside of the view distance are generated too
+    float generateDistance = m_ViewDistance + 1.5f;
+    int generateRadius = m_ViewDistance + 2;
+
+    for(int x = -generateRadius; x <= generateRadius; x++) {
+        for(int y = -generateRadius; y <= generateRadius; y++) {
+            if(glm::length(glm::vec2(x, y)) <= generateDistance) {
+                m_ChunkOffsets.push_back({ x, y });
+            }
+        }
+    }
+
+    std::sort(m_ChunkOffsets.begin(), m_ChunkOffsets.end(), [](const glm::ivec2& a, const glm::ivec2& b) {
+        return glm::length(glm::vec2(a)) < glm::length(glm::vec2(b));
+    });
+
+    // saved chunks around the spawn are read from disk while the first frames run
+    m_ChunkManager->PrefetchChunks(WorldToChunkCoordinate(m_Camera.GetPosition()), m_ViewDistance + 2);
+
+    m_StartupTime = Core::Application::GetTime();
+
     // enable depth test
     glEnable(GL_DEPTH_TEST);
 
@@ -62,11 +84,17 @@ void AppLayer::OnUpdate(float deltaTime) {
     // update chunk visibility
     Intersects::Frustum cameraFrustum = Intersects::GetFrustumFromViewProjectionMatrix(m_Camera.GetViewProjectionMatrix());
 
-    for(auto chunk = m_ChunkManager->ChunksBegin(); chunk != m_ChunkManager->ChunksEnd(); ++chunk) {
-        if(Intersects::AABBFrustum(cameraFrustum, chunk->second->GetBoundingBox())) {
-            chunk->second->Visible = true;
+    // hand the most important chunk jobs to the workers
+    m_ChunkManager->DispatchChunkJobs(m_Camera.GetPosition(), cameraFrustum);
+
+    // load meshed chunks on GPU within the frame budget
+    UploadChunks();
+
+    for(const auto& chunk : m_ChunkManager->GetChunks()) {
+        if(Intersects::AABBFrustum(cameraFrustum, chunk->GetBoundingBox())) {
+            chunk->Visible = true;
         } else {
-            chunk->second->Visible = false;
+            chunk->Visible = false;
         }
     }
 
@@ -75,6 +103,12 @@ void AppLayer::OnUpdate(float deltaTime) {
 
     // update sun 
     m_SkyBox.Update(deltaTime);
+
+    // report meshing throughput
+    UpdateJobStats(deltaTime);
+
+    // report how long the world took to show up
+    UpdateStartupStats();
 }
 
 void AppLayer::OnRender() {
@@ -94,6 +128,11 @@ bool AppLayer::OnKeyPressed(const Core::KeyPressedEvent& event) {
         m_Camera.ControlsActive[event.GetKeyCode()] = true;
     }
 
+    // switch between naive and greedy meshing
+    if(event.GetKeyCode() == GLFW_KEY_G && !event.IsRepeat()) {
+        ToggleMeshingMode();
+    }
+
     return false;
 }
 
@@ -108,27 +147,15 @@ bool AppLayer::OnKeyRelease(const Core::KeyReleasedEvent& event) {
 
 bool AppLayer::OnMouseButtonPressed(const Core::MouseButtonPressedEvent& event) {
     if(event.GetMouseButton() == GLFW_MOUSE_BUTTON_LEFT) {
-        if(m_BlockOutline.Visible) {
-            glm::vec3 cameraRay = m_Camera.CastRay();
-
-            Intersects::FaceHit faceHit;
-            glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), m_BlockOutline.Position);
-            
-            bool isFaceHit = Intersects::RayFace(m_Camera.GetPosition(), cameraRay, modelMatrix, faceHit);
-
-            if(isFaceHit) {
-                glm::vec3 newBlockPosition = m_BlockOutline.Position + faceHit.Normal;
-                Block newBlock = m_ChunkManager->GetBlock(newBlockPosition);
-
-                if(newBlock.Type == BlockType::AIR || newBlock.Type == BlockType::WATER) {
-                    // add type selection;
-                    newBlock.Type = m_SelectedItem;
-                    m_ChunkManager->CreateBlock(newBlock);
-
-                    std::shared_ptr<Chunk> chunk = m_ChunkManager->GetChunk(newBlock.Chunk);
-                    chunk->BuildMesh();
-                    chunk->LoadMesh();
-                }
+        // new block goes in front of the face the ray entered, no face if the camera is inside the block
+        if(m_BlockOutline.Visible && m_BlockOutline.Normal != glm::vec3(0.0f)) {
+            glm::vec3 newBlockPosition = m_BlockOutline.Position + m_BlockOutline.Normal;
+            Block newBlock = m_ChunkManager->GetBlock(newBlockPosition);
+
+            if(newBlock.Type == BlockType::AIR || newBlock.Type == BlockType::WATER) {
+                // add type selection;
+                newBlock.Type = m_SelectedItem;
+                m_ChunkManager->CreateBlock(newBlock);
             }
         }
     }
@@ -140,29 +167,6 @@ bool AppLayer::OnMouseButtonPressed(const Core::MouseButtonPressedEvent& event)
             removedBlock.Type = BlockType::AIR;
 
             m_ChunkManager->CreateBlock(removedBlock);
-
-            std::shared_ptr<Chunk> chunk = m_ChunkManager->GetChunk(removedBlock.Chunk);
-            chunk->BuildMesh();
-            chunk->LoadMesh();
-
-            // rebuild neighbors to avoid artifacts
-            const glm::vec3 blockNeighbours[4] = {
-                { -1.0f,  0.0f,  0.0f },
-                {  1.0f,  0.0f,  0.0f },
-                {  0.0f,  0.0f, -1.0f },
-                {  0.0f,  0.0f,  1.0f }
-            };
-
-            for(const auto& neightbor : blockNeighbours) {
-                glm::vec3 neightborPosition = m_BlockOutline.Position + neightbor;
-                Block neighborBlock = m_ChunkManager->GetBlock(neightborPosition);
-
-                if(neighborBlock.Chunk != removedBlock.Chunk) {
-                    std::shared_ptr<Chunk> neighborChunk = m_ChunkManager->GetChunk(neighborBlock.Chunk);
-                    neighborChunk->BuildMesh();
-                    neighborChunk->LoadMesh();
-                }
-            }
         }
     }
 
@@ -197,8 +201,8 @@ void AppLayer::SortChunks() {
     // sort chunks based on distance from camera
     m_ChunksSorted.clear();
 
-    for(auto chunk = m_ChunkManager->ChunksBegin(); chunk != m_ChunkManager->ChunksEnd(); ++chunk) {
-        Intersects::AABB chunkBoundingBox = chunk->second->GetBoundingBox();
+    for(const auto& chunk : m_ChunkManager->GetChunks()) {
+        Intersects::AABB chunkBoundingBox = chunk->GetBoundingBox();
         
         glm::vec2 minBound = { chunkBoundingBox.MinBound.x, chunkBoundingBox.MinBound.z };
         glm::vec2 maxBound = { chunkBoundingBox.MaxBound.x, chunkBoundingBox.MaxBound.z };
@@ -211,7 +215,7 @@ void AppLayer::SortChunks() {
         glm::vec2 diff = center - cameraPosition;
         float distance = glm::dot(diff, diff);
 
-        m_ChunksSorted.push_back({chunk->first, distance});
+        m_ChunksSorted.push_back({chunk->GetKey(), distance});
     }
 
     std::sort(m_ChunksSorted.begin(), m_ChunksSorted.end(),
@@ -229,11 +233,11 @@ void AppLayer::UpdateChunks() {
     std::vector<glm::ivec2> chunksRemoved;
     chunksRemoved.reserve(m_ViewDistance * m_ViewDistance * 4);
 
-    for(auto chunk = m_ChunkManager->ChunksBegin(); chunk != m_ChunkManager->ChunksEnd(); ++chunk) {
-        float distance = glm::length(glm::vec2(chunk->first - cameraChunk));
+    for(const auto& chunk : m_ChunkManager->GetChunks()) {
+        float distance = glm::length(glm::vec2(chunk->GetKey() - cameraChunk));
 
-        if(distance > m_ViewDistance + 1) {
-            chunksRemoved.push_back(chunk->first);
+        if(distance > m_ViewDistance + s_ChunkRemoveDistance) {
+            chunksRemoved.push_back(chunk->GetKey());
         }
     }
 
@@ -241,83 +245,152 @@ void AppLayer::UpdateChunks() {
         m_ChunkManager->DestroyChunk(chunkKey);
     }
 
-    // create chunks
-    std::vector<std::shared_ptr<Chunk>> chunksCreated;
-    chunksCreated.reserve(m_ViewDistance * m_ViewDistance * 4);
-
-    const glm::ivec2 chunkNeighbors[4] = {
-        {  0,  1 },
-        {  1,  0 },
-        {  0, -1 },
-        { -1,  0 }
-    };
-
-    // in first pass, we make sure that all the necessary chunks are there
-    for(int x = -m_ViewDistance; x <= m_ViewDistance; x++) {
-        for(int y = -m_ViewDistance; y <= m_ViewDistance; y++) {
-            glm::ivec2 chunkPosition = cameraChunk + glm::ivec2(x, y);
-            float distance = glm::length(glm::vec2(chunkPosition - cameraChunk));
+    m_ChunkManager->UpdateChunkCache();
 
-            if(distance <= m_ViewDistance) {
-                if(m_ChunkManager->ChunkExists(chunkPosition)) {
-                    std::shared_ptr<Chunk> chunk = m_ChunkManager->GetChunk(chunkPosition);
+    // create missing chunks closest first, cached ones are restored, generation and decoration run on the workers
+    std::vector<ChunkJob> generateJobs;
+    generateJobs.reserve(s_MaxChunksCreatedPerFrame);
 
-                    if(chunk->GetState() == ChunkState::CREATED) {
-                        chunk->SetState(ChunkState::DECORATED);
+    size_t chunksRestored = 0;
 
-                        chunksCreated.push_back(chunk);
-                    }
-                } else {
-                    std::shared_ptr<Chunk> chunk = m_ChunkManager->CreateChunk(chunkPosition);
-
-                    chunk->Generate();
-                    chunk->GenerateDecorations();
-                    chunk->SetState(ChunkState::DECORATED);
+    for(const auto& offset : m_ChunkOffsets) {
+        if(generateJobs.size() >= s_MaxChunksCreatedPerFrame) {
+            break;
+        }
 
-                    chunksCreated.push_back(chunk);
-                }
+        std::shared_ptr<Chunk> chunk = m_ChunkManager->CreateChunk(cameraChunk + offset);
 
-                // we do not need to mesh neighbors so we do not push it to the vector
-                for(size_t i = 0; i < 4; i++) {
-                    std::shared_ptr<Chunk> neighbor = m_ChunkManager->CreateChunk(chunkPosition + chunkNeighbors[i]);
+        if(chunk && chunk->GetState() != ChunkState::CREATED) {
+            chunksRestored++;
+        }
 
-                    if(neighbor && neighbor->GetState() == ChunkState::CREATED) {
-                        neighbor->Generate();
-                        neighbor->GenerateDecorations();
-                    }
-                }
-            }
+        if(chunk && chunk->TransitionState(ChunkState::CREATED, ChunkState::GENERATING)) {
+            generateJobs.push_back({ ChunkJobType::GENERATE, chunk });
         }
     }
 
-    if(chunksCreated.size() > 0) {
+    m_ChunkManager->AddChunkJobs(generateJobs);
+
+    if(generateJobs.size() > 0) {
         float endTime = Core::Application::GetTime();
 
-        Core::ChunksGeneratedEvent event(static_cast<int>(chunksCreated.size()), (endTime - startTime));
+        Core::ChunksGeneratedEvent event(static_cast<int>(generateJobs.size()), (endTime - startTime));
         Core::Application::Get().RaiseEvent(event);
     }
 
-    // // build meshes for the new chunks (excluding neighbors built on the fly)
-    for(const auto& chunk : chunksCreated) {
-        if(chunk->GetState() == ChunkState::DECORATED) {
-            ChunkJob job;
-            
-            job.Type = ChunkJobType::MESH;
-            job.Chunk = chunk;
+    if(generateJobs.size() > 0 || chunksRestored > 0 || chunksRemoved.size() > 0) {
+        Core::ChunksMemoryUpdatedEvent memoryEvent(static_cast<int>(m_ChunkManager->GetChunks().GetCount()), m_ChunkManager->GetMemoryUsage());
+        Core::Application::Get().RaiseEvent(memoryEvent);
+
+        const ChunkPool& chunkPool = m_ChunkManager->GetChunkPool();
+
+        Core::ChunkPoolUpdatedEvent poolEvent(static_cast<int>(chunkPool.GetCount()), chunkPool.GetHits(), chunkPool.GetMisses());
+        Core::Application::Get().RaiseEvent(poolEvent);
+
+        const ChunkCache& chunkCache = m_ChunkManager->GetChunkCache();
+
+        Core::ChunkCacheUpdatedEvent cacheEvent(static_cast<int>(chunkCache.GetCount()), chunkCache.GetMemoryUsage(), chunkCache.GetHits(), chunkCache.GetMisses());
+        Core::Application::Get().RaiseEvent(cacheEvent);
+    }
+
+    // mesh chunks in view distance once they and their neighbors are decorated
+    std::vector<ChunkJob> meshJobs;
 
-            m_ChunkManager->AddChunkJob(job);
+    for(const auto& offset : m_ChunkOffsets) {
+        if(glm::length(glm::vec2(offset)) > m_ViewDistance) {
+            break;
+        }
+
+        glm::ivec2 chunkPosition = cameraChunk + offset;
+        std::shared_ptr<Chunk> chunk = m_ChunkManager->GetChunk(chunkPosition);
+
+        if(!chunk || chunk->GetState() != ChunkState::DECORATED || !m_ChunkManager->NeighborsDecorated(chunkPosition)) {
+            continue;
+        }
 
-            chunk->SetState(ChunkState::MESHED);
+        // state has to change before a worker can pick the job up
+        if(!chunk->TransitionState(ChunkState::DECORATED, ChunkState::MESHED)) {
+            continue;
         }
+
+        meshJobs.push_back({ ChunkJobType::MESH, chunk });
     }
 
-    // load meshed chunks on GPU
-    for(auto chunk = m_ChunkManager->ChunksBegin(); chunk != m_ChunkManager->ChunksEnd(); ++chunk) {
-        if(chunk->second->GetState() == ChunkState::READY) {
-            chunk->second->LoadMesh();
-            chunk->second->SetState(ChunkState::LOADED);
+    m_ChunkManager->AddChunkJobs(meshJobs);
+}
+
+void AppLayer::UploadChunks() {
+    // collect meshed chunks, workers queue them as they finish
+    std::shared_ptr<Chunk> meshedChunk;
+
+    while(m_ChunkManager->PopMeshedChunk(meshedChunk)) {
+        m_ChunksToUpload.push_back(meshedChunk);
+    }
+
+    // chunks removed in the meantime are dropped
+    std::erase_if(m_ChunksToUpload, [](const std::shared_ptr<Chunk>& chunk) {
+        return chunk->GetState() != ChunkState::READY;
+    });
+
+    // a chunk remeshed again before its upload is queued twice, one upload takes the latest mesh
+    std::sort(m_ChunksToUpload.begin(), m_ChunksToUpload.end(), [](const auto& a, const auto& b) {
+        glm::ivec2 keyA = a->GetKey();
+        glm::ivec2 keyB = b->GetKey();
+
+        return keyA.x < keyB.x || (keyA.x == keyB.x && keyA.y < keyB.y);
+    });
+
+    auto duplicates = std::unique(m_ChunksToUpload.begin(), m_ChunksToUpload.end(), [](const auto& a, const auto& b) {
+        return a->GetKey() == b->GetKey();
+    });
+
+    m_ChunksToUpload.erase(duplicates, m_ChunksToUpload.end());
+
+    if(m_ChunksToUpload.empty()) {
+        return;
+    }
+
+    // closest chunks go first
+    glm::vec3 cameraPosition = m_Camera.GetPosition();
+
+    auto distance = [&cameraPosition](const std::shared_ptr<Chunk>& chunk) {
+        Intersects::AABB boundingBox = chunk->GetBoundingBox();
+        glm::vec2 diff = glm::vec2(boundingBox.MinBound.x + Chunk::s_ChunkSize * 0.5f, boundingBox.MinBound.z + Chunk::s_ChunkSize * 0.5f) - glm::vec2(cameraPosition.x, cameraPosition.z);
+
+        return glm::dot(diff, diff);
+    };
+
+    std::sort(m_ChunksToUpload.begin(), m_ChunksToUpload.end(), [&distance](const auto& a, const auto& b) {
+        return distance(a) < distance(b);
+    });
+
+    // upload until one of the budgets runs out
+    auto startTime = std::chrono::steady_clock::now();
+    std::chrono::duration<float> elapsed(0.0f);
+
+    size_t uploaded = 0;
+    size_t uploadedBytes = 0;
+
+    for(const auto& chunk : m_ChunksToUpload) {
+        size_t meshSize = chunk->GetMeshSize();
+
+        if(uploaded > 0 && (uploadedBytes + meshSize > m_UploadBudgetBytes || elapsed.count() > m_UploadBudgetTime)) {
+            break;
         }
+
+        chunk->TransitionState(ChunkState::READY, ChunkState::LOADED);
+        chunk->LoadMesh();
+
+        uploaded++;
+        uploadedBytes += meshSize;
+
+        elapsed = std::chrono::steady_clock::now() - startTime;
     }
+
+    m_ChunksToUpload.erase(m_ChunksToUpload.begin(), m_ChunksToUpload.begin() + uploaded);
+
+    Core::ChunkUploadsUpdatedEvent event(static_cast<int>(uploaded), static_cast<int>(m_ChunksToUpload.size()), uploadedBytes, elapsed.count());
+    Core::Application::Get().RaiseEvent(event);
 }
 
 void AppLayer::RenderChunks() {
@@ -349,51 +422,21 @@ void AppLayer::RenderChunks() {
 void AppLayer::UpdateBlockOutline() {
     glm::vec3 cameraRay = m_Camera.CastRay();
 
-    float closestDistance = Chunk::s_ChunkSize; // maximum distance from which we pick up an object
-
-    m_BlockOutline.Visible = false;
-
-    const float viewDistanceSquared = Chunk::s_ChunkSize * Chunk::s_ChunkSize * 4;
-
-    for(const auto& chunkDistance : m_ChunksSorted) {
-        std::shared_ptr<Chunk> chunk = m_ChunkManager->GetChunk(chunkDistance.Chunk);
+    // walk the ray block by block until it enters a block we can pick
+    auto solid = [this](const glm::ivec3& cell) {
+        BlockType type = m_ChunkManager->GetBlock(glm::vec3(cell)).Type;
 
-        if(!chunk->Visible) {
-            continue;
-        }
-
-        if(chunkDistance.Distance > viewDistanceSquared) {
-            continue;
-        }
-
-        for(const auto& blockPosition : chunk->BlockVisible) {
-            Block block = m_ChunkManager->GetBlock(blockPosition);
-
-            if(block.Type == BlockType::AIR || block.Type == BlockType::WATER) {
-                continue;
-            }
-
-            Intersects::AABB boundingBox = {
-                block.Position - glm::vec3(0.5f),
-                block.Position + glm::vec3(0.5f)
-            };
-
-            float distance;
-            bool highlight = Intersects::RayAABB(m_Camera.GetPosition(), cameraRay, boundingBox, distance);
-
-            if(highlight && distance < closestDistance) {
-                closestDistance = distance;
-
-                m_BlockOutline.Visible = true;
+        return type != BlockType::VOID && type != BlockType::AIR && type != BlockType::WATER;
+    };
 
-                m_BlockOutline.Chunk = chunkDistance.Chunk;
-                m_BlockOutline.Position = block.Position;
-            }
-        }
+    Intersects::VoxelHit hit;
+    m_BlockOutline.Visible = Intersects::RayVoxel(m_Camera.GetPosition(), cameraRay, s_PickDistance, solid, hit);
 
-        if(m_BlockOutline.Visible) {
-            break;
-        }
+    if(m_BlockOutline.Visible) {
+        m_BlockOutline.Chunk = WorldToChunkCoordinate(glm::vec3(hit.Cell));
+        m_BlockOutline.Position = glm::vec3(hit.Cell);
+        m_BlockOutline.Normal = hit.Normal;
+        m_BlockOutline.Distance = hit.T;
     }
 
     if(m_BlockOutline.Visible) {
@@ -414,6 +457,71 @@ void AppLayer::RenderBlockOutline() {
     }
 }
 
+void AppLayer::UpdateJobStats(float deltaTime) {
+    m_JobStats.Time += deltaTime;
+
+    if(m_JobStats.Time < 1.0f) {
+        return;
+    }
+
+    size_t chunksMeshed = m_ChunkManager->GetChunksMeshed();
+    float chunksPerSecond = (chunksMeshed - m_JobStats.ChunksMeshed) / m_JobStats.Time;
+
+    Core::ChunkJobsUpdatedEvent event(static_cast<int>(m_ChunkManager->GetWorkerCount()), chunksPerSecond,
+                                      static_cast<int>(m_ChunkManager->GetScheduledJobCount()), static_cast<int>(m_ChunkManager->GetChunkJobsCancelled()));
+    Core::Application::Get().RaiseEvent(event);
+
+    m_JobStats.ChunksMeshed = chunksMeshed;
+    m_JobStats.Time = 0.0f;
+}
+
+void AppLayer::UpdateStartupStats() {
+    if(m_WorldLoaded) {
+        return;
+    }
+
+    glm::ivec2 cameraChunk = WorldToChunkCoordinate(m_Camera.GetPosition());
+
+    for(const auto& offset : m_ChunkOffsets) {
+        if(glm::length(glm::vec2(offset)) > m_ViewDistance) {
+            break;
+        }
+
+        const std::shared_ptr<Chunk>& chunk = m_ChunkManager->GetChunk(cameraChunk + offset);
+
+        if(!chunk || chunk->GetState() != ChunkState::LOADED) {
+            return;
+        }
+    }
+
+    m_WorldLoaded = true;
+
+    Core::WorldLoadedEvent event(Core::Application::GetTime() - m_StartupTime, static_cast<int>(m_ChunkManager->GetChunksLoaded()),
+                                 static_cast<int>(m_ChunkManager->GetChunksGenerated()), m_ChunkManager->GetIOBackendName());
+    Core::Application::Get().RaiseEvent(event);
+}
+
+void AppLayer::ToggleMeshingMode() {
+    MeshingMode mode = m_ChunkManager->GetMeshingMode() == MeshingMode::GREEDY ? MeshingMode::NAIVE : MeshingMode::GREEDY;
+    m_ChunkManager->SetMeshingMode(mode);
+
+    // rebuild meshes of all loaded chunks with the new mode
+    std::vector<ChunkJob> meshJobs;
+
+    for(const auto& chunk : m_ChunkManager->GetChunks()) {
+        if(chunk->TransitionState(ChunkState::LOADED, ChunkState::MESHED)) {
+            ChunkJob job;
+
+            job.Type = ChunkJobType::MESH;
+            job.Chunk = chunk;
+
+            meshJobs.push_back(job);
+        }
+    }
+
+    m_ChunkManager->AddChunkJobs(meshJobs);
+}
+
 // TODO: move to chunk manager
 glm::ivec2 AppLayer::WorldToChunkCoordinate(const glm::vec3& position) {
     return glm::ivec2(
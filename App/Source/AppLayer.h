@@ -15,10 +15,12 @@
 
 #include <stdint.h>
 #include <memory>
+#include <optional>
 
 class AppLayer : public Core::Layer {
 public:
-    AppLayer();
+    // without a seed the world directory decides, or the default seed for a new world
+    AppLayer(std::optional<uint32_t> seed = std::nullopt);
     virtual ~AppLayer();
 
     virtual void OnEvent(Core::Event& event) override;
@@ -39,8 +41,27 @@ private:
 
     int m_ViewDistance = 12;
 
+    // chunk offsets around the camera sorted by distance, covering the view distance
+    // plus the neighbors needed to mesh the outermost chunks
+    std::vector<glm::ivec2> m_ChunkOffsets;
+
+    // chunks are kept this many chunks past the view distance, so they do not flicker on borders
+    static const int s_ChunkRemoveDistance = 2;
+
+    // bound the main thread work spent on chunks per frame
+    static const int s_MaxChunksCreatedPerFrame = 64;
+
+    // meshes uploaded per frame stop at whichever budget runs out first,
+    // at least one chunk is uploaded every frame
+    size_t m_UploadBudgetBytes = 4 * 1024 * 1024;
+    float m_UploadBudgetTime = 0.002f; // in seconds
+
+    // meshed chunks waiting for upload, carried over between frames
+    std::vector<std::shared_ptr<Chunk>> m_ChunksToUpload;
+
     void SortChunks();
     void UpdateChunks();
+    void UploadChunks();
     void RenderChunks();
 
     void UpdateBlockOutline();
@@ -48,6 +69,23 @@ private:
 
     void UpdateSun(float deltaTime);
 
+    void ToggleMeshingMode();
+
+    void UpdateJobStats(float deltaTime);
+
+    struct JobStats {
+        float Time = 0.0f;
+        size_t ChunksMeshed = 0;
+    };
+
+    JobStats m_JobStats;
+
+    // time until every chunk in view distance was first loaded, from region files or noise
+    void UpdateStartupStats();
+
+    float m_StartupTime = 0.0f;
+    bool m_WorldLoaded = false;
+
     glm::ivec2 WorldToChunkCoordinate(const glm::vec3& position);
 
     struct ChunkDistance { 
@@ -60,6 +98,8 @@ private:
     struct BlockOutline {
         glm::vec2 Chunk;
         glm::vec3 Position;
+        glm::vec3 Normal; // face the camera ray entered
+        float Distance = 0.0f;
 
         BoundingBox BoundingBox;
 
@@ -67,6 +107,9 @@ private:
     };
 
     BlockOutline m_BlockOutline;
+
+    // how far blocks can be picked
+    static constexpr float s_PickDistance = 16.0f;
     SkyBox m_SkyBox;
     
     Camera m_Camera;
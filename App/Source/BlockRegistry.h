@@ -0,0 +1,74 @@
+#pragma once
+
+#include "BlockType.h"
+
+#include <glm/glm.hpp>
+
+#include <iterator>
+
+struct BlockInfo {
+    // atlas tile of every face: front, back, left, right, top, bottom
+    glm::ivec2 Tiles[6];
+
+    // has faces to mesh
+    bool Visible;
+
+    // hides the faces of blocks next to it
+    bool Opaque;
+
+    // meshed into the translucent mesh, drawn after all opaque ones
+    bool Translucent;
+
+    // darkens the ambient occlusion of faces around it
+    bool Occludes;
+
+    // faces are hidden only by the same block, like water surfaces
+    bool Liquid;
+};
+
+// Properties of every block type, indexed by BlockType. Meshing reads them in its
+// inner loops, so they are plain constant arrays instead of per-chunk maps.
+namespace BlockRegistry {
+
+    constexpr BlockInfo Uniform(glm::ivec2 tile, bool opaque, bool translucent, bool occludes, bool liquid = false) {
+        return { { tile, tile, tile, tile, tile, tile }, true, opaque, translucent, occludes, liquid };
+    }
+
+    constexpr BlockInfo Column(glm::ivec2 side, glm::ivec2 top, glm::ivec2 bottom) {
+        return { { side, side, side, side, top, bottom }, true, true, false, true, false };
+    }
+
+    inline constexpr BlockInfo s_Blocks[] = {
+        // void, everything outside of the loaded world: hides faces and occludes like a solid block
+        { {}, false, true, false, true, false },
+        // air
+        { {}, false, false, false, false, false },
+        // stone
+        Uniform({ 1, 0 }, true, false, true),
+        // dirt
+        Uniform({ 2, 0 }, true, false, true),
+        // grass
+        Column({ 3, 0 }, { 0, 0 }, { 2, 0 }),
+        // water
+        Uniform({ 14, 0 }, false, true, false, true),
+        // sand
+        Uniform({ 2, 1 }, true, false, true),
+        // wood
+        Column({ 4, 1 }, { 5, 1 }, { 5, 1 }),
+        // leaves
+        Uniform({ 6, 1 }, false, true, false),
+        // cobblestone
+        Uniform({ 0, 1 }, true, false, true),
+        // planks
+        Uniform({ 4, 0 }, true, false, true),
+        // glass
+        Uniform({ 1, 3 }, false, true, true)
+    };
+
+    static_assert(std::size(s_Blocks) == BlockType::GLASS + 1, "every block type needs a registry entry");
+
+    constexpr const BlockInfo& Get(BlockType type) {
+        return s_Blocks[type];
+    }
+
+}
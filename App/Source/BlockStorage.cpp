@@ -0,0 +1,323 @@
+#include "BlockStorage.h"
+#include "BlockRegistry.h"
+
+#include <assert.h>
+#include <string.h>
+#include <algorithm>
+
+template<int Bits>
+static void UnpackIndices(const uint64_t* words, uint8_t* indices, size_t size) {
+    const size_t perWord = 64 / Bits;
+    const uint64_t mask = (uint64_t(1) << Bits) - 1;
+
+    for(size_t i = 0; i < size; i += perWord) {
+        uint64_t word = words[i / perWord];
+
+        for(size_t j = 0; j < perWord && i + j < size; j++) {
+            indices[i + j] = static_cast<uint8_t>((word >> (j * Bits)) & mask);
+        }
+    }
+}
+
+template<int Bits>
+static void PackIndices(const uint8_t* indices, uint64_t* words, size_t size) {
+    const size_t perWord = 64 / Bits;
+
+    for(size_t i = 0; i < size; i += perWord) {
+        uint64_t word = 0;
+
+        for(size_t j = 0; j < perWord && i + j < size; j++) {
+            word |= uint64_t(indices[i + j]) << (j * Bits);
+        }
+
+        words[i / perWord] = word;
+    }
+}
+
+BlockStorage::BlockStorage(size_t size, BlockType type) {
+    m_Size = size;
+
+    Fill(type);
+}
+
+BlockStorage::~BlockStorage() {
+
+}
+
+BlockType BlockStorage::Get(size_t index) const {
+    if(m_BitsPerBlock == 0) {
+        return m_Palette[0];
+    }
+
+    return m_Palette[GetIndex(index)];
+}
+
+void BlockStorage::Set(size_t index, BlockType type) {
+    if(m_BitsPerBlock == 0 && m_Palette[0] == type) {
+        return;
+    }
+
+    auto entry = std::find(m_Palette.begin(), m_Palette.end(), type);
+    uint32_t paletteIndex = static_cast<uint32_t>(entry - m_Palette.begin());
+
+    if(entry == m_Palette.end()) {
+        m_Palette.push_back(type);
+
+        // grow indices when the palette does not fit anymore
+        if(m_Palette.size() > (size_t(1) << m_BitsPerBlock)) {
+            Resize(m_BitsPerBlock == 0 ? 1 : m_BitsPerBlock * 2);
+        }
+    }
+
+    SetIndex(index, paletteIndex);
+}
+
+void BlockStorage::Fill(BlockType type) {
+    m_Palette.clear();
+    m_Palette.push_back(type);
+
+    m_BitsPerBlock = 0;
+
+    // release the index array, uniform storage does not need it
+    std::vector<uint64_t>().swap(m_Data);
+}
+
+void BlockStorage::Reset(BlockType type) {
+    m_Palette.clear();
+    m_Palette.push_back(type);
+
+    m_BitsPerBlock = 0;
+
+    m_Data.clear();
+}
+
+void BlockStorage::Compact() {
+    if(m_BitsPerBlock == 0) {
+        return;
+    }
+
+    // count which palette entries are still in use
+    std::vector<size_t> counts(m_Palette.size(), 0);
+
+    for(size_t i = 0; i < m_Size; i++) {
+        counts[GetIndex(i)]++;
+    }
+
+    std::vector<BlockType> palette;
+    std::vector<uint32_t> remap(m_Palette.size(), 0);
+
+    for(size_t i = 0; i < m_Palette.size(); i++) {
+        if(counts[i] > 0) {
+            remap[i] = static_cast<uint32_t>(palette.size());
+            palette.push_back(m_Palette[i]);
+        }
+    }
+
+    if(palette.size() == 1) {
+        Fill(palette[0]);
+        return;
+    }
+
+    if(palette.size() == m_Palette.size()) {
+        return;
+    }
+
+    int bitsPerBlock = 1;
+
+    while(palette.size() > (size_t(1) << bitsPerBlock)) {
+        bitsPerBlock *= 2;
+    }
+
+    std::vector<uint32_t> indices(m_Size);
+
+    for(size_t i = 0; i < m_Size; i++) {
+        indices[i] = remap[GetIndex(i)];
+    }
+
+    m_Palette = std::move(palette);
+    m_BitsPerBlock = bitsPerBlock;
+    m_Data.assign((m_Size * m_BitsPerBlock + 63) / 64, 0);
+
+    for(size_t i = 0; i < m_Size; i++) {
+        SetIndex(i, indices[i]);
+    }
+}
+
+bool BlockStorage::IsUniform() const {
+    return m_BitsPerBlock == 0;
+}
+
+void BlockStorage::GetIndices(uint8_t* indices) const {
+    if(m_BitsPerBlock == 0) {
+        memset(indices, 0, m_Size);
+        return;
+    }
+
+    // one loop per width, so the shifts are constants the compiler can vectorize
+    switch(m_BitsPerBlock) {
+        case 1: UnpackIndices<1>(m_Data.data(), indices, m_Size); break;
+        case 2: UnpackIndices<2>(m_Data.data(), indices, m_Size); break;
+        case 4: UnpackIndices<4>(m_Data.data(), indices, m_Size); break;
+        case 8: UnpackIndices<8>(m_Data.data(), indices, m_Size); break;
+    }
+}
+
+bool BlockStorage::SetIndices(const std::vector<BlockType>& palette, const uint8_t* indices) {
+    if(palette.empty() || palette.size() > (size_t(1) << s_MaxBitsPerBlock)) {
+        return false;
+    }
+
+    // unknown block types have no registry entry to render them with
+    for(auto type : palette) {
+        if(type >= std::size(BlockRegistry::s_Blocks)) {
+            return false;
+        }
+    }
+
+    uint8_t maxIndex = 0;
+
+    for(size_t i = 0; i < m_Size; i++) {
+        maxIndex = std::max(maxIndex, indices[i]);
+    }
+
+    // an index past the palette would read out of bounds later
+    if(maxIndex >= palette.size()) {
+        return false;
+    }
+
+    if(palette.size() == 1) {
+        Reset(palette[0]);
+        return true;
+    }
+
+    int bitsPerBlock = 1;
+
+    while(palette.size() > (size_t(1) << bitsPerBlock)) {
+        bitsPerBlock *= 2;
+    }
+
+    m_Palette = palette;
+    m_BitsPerBlock = bitsPerBlock;
+    m_Data.assign((m_Size * m_BitsPerBlock + 63) / 64, 0);
+
+    switch(m_BitsPerBlock) {
+        case 1: PackIndices<1>(indices, m_Data.data(), m_Size); break;
+        case 2: PackIndices<2>(indices, m_Data.data(), m_Size); break;
+        case 4: PackIndices<4>(indices, m_Data.data(), m_Size); break;
+        case 8: PackIndices<8>(indices, m_Data.data(), m_Size); break;
+    }
+
+    return true;
+}
+
+bool BlockStorage::Deserialize(const uint8_t*& cursor, const uint8_t* end) {
+    if(end - cursor < 2) {
+        return false;
+    }
+
+    int bitsPerBlock = cursor[0];
+    size_t paletteSize = static_cast<size_t>(cursor[1]) + 1;
+
+    cursor += 2;
+
+    if(bitsPerBlock > s_MaxBitsPerBlock || (bitsPerBlock & (bitsPerBlock - 1)) != 0 || paletteSize > (size_t(1) << bitsPerBlock)) {
+        return false;
+    }
+
+    size_t wordCount = bitsPerBlock == 0 ? 0 : (m_Size * bitsPerBlock + 63) / 64;
+
+    if(static_cast<size_t>(end - cursor) < paletteSize + wordCount * sizeof(uint64_t)) {
+        return false;
+    }
+
+    m_Palette.clear();
+
+    for(size_t i = 0; i < paletteSize; i++) {
+        // unknown block types have no registry entry to render them with
+        if(cursor[i] >= std::size(BlockRegistry::s_Blocks)) {
+            Reset();
+            return false;
+        }
+
+        m_Palette.push_back(static_cast<BlockType>(cursor[i]));
+    }
+
+    cursor += paletteSize;
+
+    m_BitsPerBlock = bitsPerBlock;
+    m_Data.resize(wordCount);
+
+    memcpy(m_Data.data(), cursor, wordCount * sizeof(uint64_t));
+    cursor += wordCount * sizeof(uint64_t);
+
+    // an index past the palette would read out of bounds later
+    for(size_t i = 0; bitsPerBlock > 0 && i < m_Size; i++) {
+        if(GetIndex(i) >= paletteSize) {
+            Reset();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int BlockStorage::GetBitsPerBlock() const {
+    return m_BitsPerBlock;
+}
+
+size_t BlockStorage::GetPaletteSize() const {
+    return m_Palette.size();
+}
+
+const std::vector<BlockType>& BlockStorage::GetPalette() const {
+    return m_Palette;
+}
+
+size_t BlockStorage::GetSize() const {
+    return m_Size;
+}
+
+size_t BlockStorage::GetMemoryUsage() const {
+    return sizeof(BlockStorage) + m_Palette.capacity() * sizeof(BlockType) + m_Data.capacity() * sizeof(uint64_t);
+}
+
+uint32_t BlockStorage::GetIndex(size_t index) const {
+    // bits per block is a power of two, so an index never crosses a word boundary
+    size_t bit = index * m_BitsPerBlock;
+    uint64_t mask = (uint64_t(1) << m_BitsPerBlock) - 1;
+
+    return static_cast<uint32_t>((m_Data[bit >> 6] >> (bit & 63)) & mask);
+}
+
+void BlockStorage::SetIndex(size_t index, uint32_t value) {
+    size_t bit = index * m_BitsPerBlock;
+    uint64_t mask = (uint64_t(1) << m_BitsPerBlock) - 1;
+
+    uint64_t& word = m_Data[bit >> 6];
+    word = (word & ~(mask << (bit & 63))) | ((uint64_t(value) & mask) << (bit & 63));
+}
+
+void BlockStorage::Resize(int bitsPerBlock) {
+    assert(bitsPerBlock <= s_MaxBitsPerBlock);
+
+    int previousBitsPerBlock = m_BitsPerBlock;
+
+    m_BitsPerBlock = bitsPerBlock;
+
+    // uniform storage maps every block to palette entry 0, which is already zero,
+    // and the array is filled in place so a reset storage reuses its memory
+    if(previousBitsPerBlock == 0) {
+        m_Data.assign((m_Size * m_BitsPerBlock + 63) / 64, 0);
+        return;
+    }
+
+    std::vector<uint64_t> data = std::move(m_Data);
+    m_Data.assign((m_Size * m_BitsPerBlock + 63) / 64, 0);
+
+    uint64_t mask = (uint64_t(1) << previousBitsPerBlock) - 1;
+
+    for(size_t i = 0; i < m_Size; i++) {
+        size_t bit = i * previousBitsPerBlock;
+        SetIndex(i, static_cast<uint32_t>((data[bit >> 6] >> (bit & 63)) & mask));
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "BlockType.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+// Palette-compressed block storage. Every block is stored as an index into a
+// small palette of block types, and indices are bit-packed into 64-bit words
+// using 1, 2, 4 or 8 bits per block. The width grows on demand when a new
+// block type no longer fits into the palette. Storage holding a single block
+// type uses 0 bits and keeps no index array at all.
+class BlockStorage {
+public:
+    BlockStorage(size_t size, BlockType type = BlockType::AIR);
+    ~BlockStorage();
+
+    BlockType Get(size_t index) const;
+    void Set(size_t index, BlockType type);
+
+    void Fill(BlockType type);
+
+    // like Fill, but the index array keeps its memory for the blocks set next
+    void Reset(BlockType type = BlockType::AIR);
+    void Compact();
+
+    bool IsUniform() const;
+
+    // palette indices unpacked to one byte per block, indices holds GetSize() bytes
+    void GetIndices(uint8_t* indices) const;
+    // replaces the blocks, false if the palette has unknown types or an index is past it
+    bool SetIndices(const std::vector<BlockType>& palette, const uint8_t* indices);
+
+    // reads the palette and the packed indices as they were in memory, the layout of
+    // version 1 chunk data, and moves cursor past them, false if the data is not valid
+    bool Deserialize(const uint8_t*& cursor, const uint8_t* end);
+
+    int GetBitsPerBlock() const;
+    size_t GetPaletteSize() const;
+    const std::vector<BlockType>& GetPalette() const;
+    size_t GetSize() const;
+    size_t GetMemoryUsage() const;
+private:
+    uint32_t GetIndex(size_t index) const;
+    void SetIndex(size_t index, uint32_t value);
+
+    void Resize(int bitsPerBlock);
+private:
+    static const int s_MaxBitsPerBlock = 8;
+
+    size_t m_Size = 0;
+    int m_BitsPerBlock = 0;
+
+    std::vector<BlockType> m_Palette;
+    std::vector<uint64_t> m_Data;
+};
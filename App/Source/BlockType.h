@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdint.h>
+
+enum BlockType : uint8_t {
+    VOID,
+    AIR,
+    STONE,
+    DIRT,
+    GRASS,
+    WATER,
+    SAND,
+    WOOD,
+    LEAVES,
+    COBBLESTONE,
+    PLANKS,
+    GLASS
+};
@@ -1,5 +1,9 @@
 #include "Chunk.h"
 #include "ChunkManager.h"
+#include "ChunkSnapshot.h"
+#include "ChunkCodec.h"
+
+#include "Core/Renderer/QuadIndexBuffer.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -13,280 +17,280 @@ Chunk::Chunk(ChunkManager* chunkManager,
     m_Key = key;
     m_TextureAtlas = textureAtlas;
     m_Shader = shader;
-
-    // fill the chunk with air (like a baloon) :D
-    for(auto& a: m_BlockTypes) {
-        for(auto& b : a) {
-            b.fill(BlockType::AIR);
-        }
-    }
-
-    // create block types
-    // stone
-    m_BlockTypesUVsMap[Direction::ALL][BlockType::STONE] = { 1, 0 };
-
-    // grass
-    m_BlockTypesUVsMap[Direction::FRONT][BlockType::GRASS] = { 3, 0 };
-    m_BlockTypesUVsMap[Direction::BACK][BlockType::GRASS] = { 3, 0 };
-    m_BlockTypesUVsMap[Direction::LEFT][BlockType::GRASS] = { 3, 0 };
-    m_BlockTypesUVsMap[Direction::RIGHT][BlockType::GRASS] = { 3, 0 };
-    m_BlockTypesUVsMap[Direction::TOP][BlockType::GRASS] = { 0, 0 };
-    m_BlockTypesUVsMap[Direction::BOTTOM][BlockType::GRASS] = { 2, 0 };
-
-    // dirt
-    m_BlockTypesUVsMap[Direction::ALL][BlockType::DIRT] = { 2, 0 };
-
-    // water
-    m_BlockTypesUVsMap[Direction::ALL][BlockType::WATER] = { 14, 0 };
-
-    // sand
-    m_BlockTypesUVsMap[Direction::ALL][BlockType::SAND] = { 2, 1 };
-
-    // wood
-    m_BlockTypesUVsMap[Direction::FRONT][BlockType::WOOD] = { 4, 1 };
-    m_BlockTypesUVsMap[Direction::BACK][BlockType::WOOD] = { 4, 1 };
-    m_BlockTypesUVsMap[Direction::LEFT][BlockType::WOOD] ={ 4, 1 };
-    m_BlockTypesUVsMap[Direction::RIGHT][BlockType::WOOD] = { 4, 1 };
-    m_BlockTypesUVsMap[Direction::TOP][BlockType::WOOD] = { 5, 1 };
-    m_BlockTypesUVsMap[Direction::BOTTOM][BlockType::WOOD] = { 5, 1 };
-
-    // leaves
-    m_BlockTypesUVsMap[Direction::ALL][BlockType::LEAVES] = { 6, 1 };
-
-    // cobblestone
-    m_BlockTypesUVsMap[Direction::ALL][BlockType::COBBLESTONE] = { 0, 1 };
-
-    // planks
-    m_BlockTypesUVsMap[Direction::ALL][BlockType::PLANKS] = { 4, 0 };
-
-    // glass
-    m_BlockTypesUVsMap[Direction::ALL][BlockType::GLASS] = { 1, 3 };
-
-    // ambient occlusion
-    // FRONT (+Z)
-    m_VertexNeighbors[3][Direction::FRONT] = { { {  0, +1,  0 }, { -1,  0,  0 }, { -1, +1,  0 } } }; // v0
-    m_VertexNeighbors[2][Direction::FRONT] = { { {  0, +1,  0 }, { +1,  0,  0 }, { +1, +1,  0 } } }; // v1
-    m_VertexNeighbors[1][Direction::FRONT] = { { {  0, -1,  0 }, { +1,  0,  0 }, { +1, -1,  0 } } }; // v2
-    m_VertexNeighbors[0][Direction::FRONT] = { { {  0, -1,  0 }, { -1,  0,  0 }, { -1, -1,  0 } } }; // v3
-
-    // BACK (-Z)
-    m_VertexNeighbors[3][Direction::BACK] = { { {  0, +1,  0 }, { +1,  0,  0 }, { +1, +1,  0 } } }; // v0
-    m_VertexNeighbors[2][Direction::BACK] = { { {  0, +1,  0 }, { -1,  0,  0 }, { -1, +1,  0 } } }; // v1
-    m_VertexNeighbors[1][Direction::BACK] = { { {  0, -1,  0 }, { -1,  0,  0 }, { -1, -1,  0 } } }; // v2
-    m_VertexNeighbors[0][Direction::BACK] = { { {  0, -1,  0 }, { +1,  0,  0 }, { +1, -1,  0 } } }; // v3
-
-    // LEFT (-X)
-    m_VertexNeighbors[3][Direction::LEFT] = { { {  0, +1,  0 }, {  0,  0, -1 }, {  0, +1, -1 } } }; // v0
-    m_VertexNeighbors[2][Direction::LEFT] = { { {  0, +1,  0 }, {  0,  0, +1 }, {  0, +1, +1 } } }; // v1
-    m_VertexNeighbors[1][Direction::LEFT] = { { {  0, -1,  0 }, {  0,  0, +1 }, {  0, -1, +1 } } }; // v2
-    m_VertexNeighbors[0][Direction::LEFT] = { { {  0, -1,  0 }, {  0,  0, -1 }, {  0, -1, -1 } } }; // v3
-
-    // RIGHT (+X)
-    m_VertexNeighbors[3][Direction::RIGHT] = { { {  0, +1,  0 }, {  0,  0, +1 }, {  0, +1, +1 } } }; // v0
-    m_VertexNeighbors[2][Direction::RIGHT] = { { {  0, +1,  0 }, {  0,  0, -1 }, {  0, +1, -1 } } }; // v1
-    m_VertexNeighbors[1][Direction::RIGHT] = { { {  0, -1,  0 }, {  0,  0, -1 }, {  0, -1, -1 } } }; // v2
-    m_VertexNeighbors[0][Direction::RIGHT] = { { {  0, -1,  0 }, {  0,  0, +1 }, {  0, -1, +1 } } }; // v3
-
-    // TOP (+Y)
-    m_VertexNeighbors[3][Direction::TOP] = { { {  0,  0, -1 }, { -1,  0,  0 }, { -1,  0, -1 } } }; // v0
-    m_VertexNeighbors[2][Direction::TOP] = { { {  0,  0, -1 }, { +1,  0,  0 }, { +1,  0, -1 } } }; // v1
-    m_VertexNeighbors[1][Direction::TOP] = { { {  0,  0, +1 }, { +1,  0,  0 }, { +1,  0, +1 } } }; // v2
-    m_VertexNeighbors[0][Direction::TOP] = { { {  0,  0, +1 }, { -1,  0,  0 }, { -1,  0, +1 } } }; // v3
-
-    // BOTTOM (-Y)
-    m_VertexNeighbors[0][Direction::BOTTOM] = { { {  0,  0, -1 }, { -1,  0,  0 }, { -1,  0, -1 } } }; // v0
-    m_VertexNeighbors[1][Direction::BOTTOM] = { { {  0,  0, -1 }, { +1,  0,  0 }, { +1,  0, -1 } } }; // v1
-    m_VertexNeighbors[2][Direction::BOTTOM] = { { {  0,  0, +1 }, { +1,  0,  0 }, { +1,  0, +1 } } }; // v2
-    m_VertexNeighbors[3][Direction::BOTTOM] = { { {  0,  0, +1 }, { -1,  0,  0 }, { -1,  0, +1 } } }; // v3
-
-    BlockVisible.reserve(s_ChunkSize * s_ChunkSize);
 }
 
 Chunk::~Chunk() {
 
 }
 
-void Chunk::Generate() {
+void Chunk::Generate(const WorldGenerator& generator) {
     // create height map
-    Perlin perlin(1234567890);
-    m_HeightMap = CreateHeightMap(perlin, 0.01f, 4, 0.5f);
+    m_HeightMap = CreateHeightMap(generator);
 
     // update block types
     for(int x = 0; x < s_ChunkSize; x++) {
         for(int z = 0; z < s_ChunkSize; z++) {
-            // max height is 32 blocks
-            int height = static_cast<int>(std::floor(m_HeightMap[z * s_ChunkSize + x] * s_ChunkSize * 3 + s_ChunkSize * 2));
+            int height = WorldGenerator::GetTerrainHeight(m_HeightMap[z * s_ChunkSize + x]);
 
             // fill chunk with stone
             for(int y = 0; y < height; y++) {
-                m_BlockTypes[x][y][z] = BlockType::STONE;
+                SetBlockType(glm::vec3(x, y, z), BlockType::STONE);
             }
 
             // replace top chunks with grass and dirt
-            m_BlockTypes[x][height - 1][z] = BlockType::GRASS;
+            SetBlockType(glm::vec3(x, height - 1, z), BlockType::GRASS);
 
             if(height > 3) {
-                m_BlockTypes[x][height - 2][z] = BlockType::DIRT;
-                m_BlockTypes[x][height - 3][z] = BlockType::DIRT;
-                m_BlockTypes[x][height - 4][z] = BlockType::DIRT;
+                SetBlockType(glm::vec3(x, height - 2, z), BlockType::DIRT);
+                SetBlockType(glm::vec3(x, height - 3, z), BlockType::DIRT);
+                SetBlockType(glm::vec3(x, height - 4, z), BlockType::DIRT);
             }
 
             // everything that is height <= s_WaterLevel should be filled with water
             if(height < s_WaterLevel) {
                 for(int y = height; y < s_WaterLevel; y++) {
-                    m_BlockTypes[x][y][z] = BlockType::WATER;
+                    SetBlockType(glm::vec3(x, y, z), BlockType::WATER);
                 }
 
-                m_BlockTypes[x][height - 1][z] = BlockType::SAND;
+                SetBlockType(glm::vec3(x, height - 1, z), BlockType::SAND);
             }
         }
     }
 }
 
-void Chunk::GenerateDecorations() {
-    // create heigh map
-    Perlin perlin(1234567890);
-    std::array<float, s_ChunkSize * s_ChunkSize> heightMap = CreateHeightMap(perlin, 0.6f, 4, 0.1f);
+void Chunk::GenerateDecorations(const WorldGenerator& generator) {
+    // place trees, the ones rooted in the neighbor border reach into this chunk, so every
+    // chunk places its own part of them and never writes into neighbor chunks
+    const int border = 1;
 
-    // place trees
-    float threshold = 0.75f;
+    for(int x = -border; x < s_ChunkSize + border; x++) {
+        for(int z = -border; z < s_ChunkSize + border; z++) {
+            float worldX = m_Position.x + x;
+            float worldZ = m_Position.z + z;
 
-    for(int x = 0; x < s_ChunkSize; x++) {
-        for(int z = 0; z < s_ChunkSize; z++) {
-            int height = static_cast<int>(std::floor(m_HeightMap[z * s_ChunkSize + x] * s_ChunkSize * 3 + s_ChunkSize * 2));
+            bool inside = x >= 0 && x < s_ChunkSize && z >= 0 && z < s_ChunkSize;
+            float terrain = inside ? m_HeightMap[z * s_ChunkSize + x] : generator.GetTerrainNoise(worldX, worldZ);
+            int height = WorldGenerator::GetTerrainHeight(terrain);
 
-            BlockType type = m_BlockTypes[x][height][z];
-
-            if(type == BlockType::WATER) {
+            // block on top of the terrain is water
+            if(height < s_WaterLevel) {
                 continue;
             }
 
-            if(heightMap[z * s_ChunkSize + x] > threshold) {
+            if(generator.HasTree(worldX, worldZ)) {
                 glm::vec3 position = { x, height, z };
                 PlaceTree(position);
             }
         }
     }
+
+    CompactSections();
 }
 
 void Chunk::ResetMesh() {
-    m_OpaqueMesh.Reset();
-    m_TranslucentMesh.Reset();
+    for(auto& sectionMesh : m_SectionMeshes) {
+        sectionMesh.Opaque.Reset();
+        sectionMesh.Translucent.Reset();
+    }
 }
 
-void Chunk::BuildMesh() {
-    BlockVisible.clear();
+void Chunk::ClearMesh() {
+    for(auto& sectionMesh : m_SectionMeshes) {
+        sectionMesh.Opaque.Clear();
+        sectionMesh.Translucent.Clear();
+    }
+}
 
-    for(int x = 0; x < s_ChunkSize; x++) {
-        for(int y = 0; y < s_ChunkSize * s_ChunkSize; y++) {
-            for(int z = 0; z < s_ChunkSize; z++) {
-                BlockType type = m_BlockTypes[x][y][z];
+void Chunk::BuildMesh(const ChunkSnapshot& snapshot) {
+    BuildMesh(snapshot, m_ChunkManager->GetMeshingMode());
+}
 
-                if(type == BlockType::AIR)
-                    continue;
+void Chunk::BuildMesh(const ChunkSnapshot& snapshot, MeshingMode mode) {
+    for(int section = 0; section < s_SectionCount; section++) {
+        BuildSectionMesh(snapshot, section, mode);
+    }
+}
 
-                glm::vec3 position = glm::vec3(x, y, z);
-                BlockMesh blockMesh = CreateBlockMesh(position, type);
+void Chunk::BuildSectionMesh(const ChunkSnapshot& snapshot, int section) {
+    BuildSectionMesh(snapshot, section, m_ChunkManager->GetMeshingMode());
+}
 
-                if(blockMesh.Visible) {
-                    if(blockMesh.Type == BlockType::WATER || blockMesh.Type == BlockType::LEAVES || blockMesh.Type == BlockType::GLASS) {
-                        m_TranslucentMeshConfig.Vertices.insert(m_TranslucentMeshConfig.Vertices.end(), blockMesh.Vertices.begin(), blockMesh.Vertices.end());
+void Chunk::BuildSectionMesh(const ChunkSnapshot& snapshot, int section, MeshingMode mode) {
+    // chunks meshed outside of the job system get their own buffers
+    if(!m_MeshStaging) {
+        m_MeshStaging = std::make_unique<ChunkMeshStaging>();
+    }
 
-                        for(size_t i = 0; i < blockMesh.Indices.size(); i ++) {
-                            m_TranslucentMeshConfig.Indices.push_back(m_TranslucentMeshConfig.IndexOffset + blockMesh.Indices[i]);
-                        }
+    m_MeshStaging->Opaque[section].Vertices.clear();
+    m_MeshStaging->Translucent[section].Vertices.clear();
 
-                        m_TranslucentMeshConfig.IndexOffset += blockMesh.IndexOffset;
-                    } else {
-                        m_OpaqueMeshConfig.Vertices.insert(m_OpaqueMeshConfig.Vertices.end(), blockMesh.Vertices.begin(), blockMesh.Vertices.end());
+    // empty mesh still has to be uploaded to replace the old one
+    m_MeshStaging->SectionsBuilt |= 1u << section;
 
-                        for(size_t i = 0; i < blockMesh.Indices.size(); i ++) {
-                            m_OpaqueMeshConfig.Indices.push_back(m_OpaqueMeshConfig.IndexOffset + blockMesh.Indices[i]);
-                        }
+    // skip sections of air and sections buried under solid blocks
+    if(snapshot.SectionHidden(section)) {
+        return;
+    }
 
-                        m_OpaqueMeshConfig.IndexOffset += blockMesh.IndexOffset;
-                    }
-                    
-                    BlockVisible.push_back(m_Position + position);
-                }
-            }
-        }
+    if(mode == MeshingMode::GREEDY) {
+        BuildGreedySectionMesh(snapshot, section);
+    } else {
+        BuildNaiveSectionMesh(snapshot, section);
     }
 }
 
 void Chunk::LoadMesh() {
-    ResetMesh();
+    if(!m_MeshStaging) {
+        return;
+    }
 
-    m_OpaqueMesh.Build(m_OpaqueMeshConfig.Vertices, m_OpaqueMeshConfig.Indices);
-    m_TranslucentMesh.Build(m_TranslucentMeshConfig.Vertices, m_TranslucentMeshConfig.Indices);
+    for(int section = 0; section < s_SectionCount; section++) {
+        if(!(m_MeshStaging->SectionsBuilt & (1u << section))) {
+            continue;
+        }
 
-    // clean up
-    m_OpaqueMeshConfig.Vertices.clear();
-    m_OpaqueMeshConfig.Indices.clear();
-    m_OpaqueMeshConfig.IndexOffset = 0;
+        // empty meshes replace the old ones too, GL objects are kept and refilled
+        m_SectionMeshes[section].Opaque.Build(m_MeshStaging->Opaque[section].Vertices);
+        m_SectionMeshes[section].Translucent.Build(m_MeshStaging->Translucent[section].Vertices);
+    }
 
-    m_TranslucentMeshConfig.Vertices.clear();
-    m_TranslucentMeshConfig.Indices.clear();
-    m_TranslucentMeshConfig.IndexOffset = 0;
+    m_ChunkManager->ReleaseMeshStaging(std::move(m_MeshStaging));
 }
 
-void Chunk::RenderOpaqueMesh(const Camera& camera, const SkyBox& skybox) {
-    if(m_OpaqueMesh.GetIndexCount() > 0) {
-        // enable shader
-        m_Shader->Use();
+void Chunk::Recycle(glm::ivec2 key) {
+    m_Key = key;
+    m_State = ChunkState::CREATED;
 
-        // bind uniforms
-        m_Shader->SetMat4("u_Projection", camera.GetProjectionMatrix());
-        m_Shader->SetMat4("u_View", camera.GetViewMatrix());
-        m_Shader->SetMat4("u_Model", glm::translate(glm::mat4(1.0f), m_Position));
+    Visible = false;
+    m_DirtySections = 0;
+    m_HeightMap.fill(0.0f);
 
-        // bind lighting uniforms
-        m_Shader->SetVec3("u_SunDirection", skybox.GetSunDirection());
-        m_Shader->SetVec3("u_SunColor", skybox.GetSunColor());
-        m_Shader->SetVec3("u_AmbientColor", skybox.GetAmbientColor());
+    // block arrays and GL objects keep their memory for the new chunk
+    for(auto& section : m_Sections) {
+        section.Reset();
+    }
 
-        // distance fog
-        m_Shader->SetVec3("u_CameraPosition", camera.GetPosition());
-        m_Shader->SetFloat("u_FogStart", 160.0f);
-        m_Shader->SetFloat("u_FogEnd", 176.0f);
+    ClearMesh();
 
-        // bind texture atlas
-        m_TextureAtlas->GetTexture()->Bind();
+    // mesh built but never uploaded
+    if(m_MeshStaging) {
+        m_ChunkManager->ReleaseMeshStaging(std::move(m_MeshStaging));
+    }
+}
+
+void ChunkMeshStaging::Clear() {
+    for(int section = 0; section < Chunk::s_SectionCount; section++) {
+        Opaque[section].Vertices.clear();
+        Translucent[section].Vertices.clear();
+    }
+
+    SectionsBuilt = 0;
+}
+
+void Chunk::SetMeshStaging(std::unique_ptr<ChunkMeshStaging> staging) {
+    m_MeshStaging = std::move(staging);
+}
+
+bool Chunk::HasMeshStaging() const {
+    return m_MeshStaging != nullptr;
+}
+
+const ChunkMeshStaging* Chunk::GetMeshStaging() const {
+    return m_MeshStaging.get();
+}
+
+size_t Chunk::GetMeshSize() const {
+    size_t size = 0;
+
+    if(!m_MeshStaging) {
+        return size;
+    }
+
+    for(int section = 0; section < s_SectionCount; section++) {
+        size += m_MeshStaging->Opaque[section].Vertices.size() * sizeof(Renderer::ChunkVertex);
+        size += m_MeshStaging->Translucent[section].Vertices.size() * sizeof(Renderer::ChunkVertex);
+    }
+
+    return size;
+}
+
+size_t Chunk::GetLoadedMeshSize() {
+    size_t quads = 0;
+
+    for(auto& sectionMesh : m_SectionMeshes) {
+        quads += sectionMesh.Opaque.GetIndexCount() / Renderer::QuadIndexBuffer::s_IndicesPerQuad;
+        quads += sectionMesh.Translucent.GetIndexCount() / Renderer::QuadIndexBuffer::s_IndicesPerQuad;
+    }
+
+    return quads * Renderer::QuadIndexBuffer::s_VerticesPerQuad * sizeof(Renderer::ChunkVertex);
+}
+
+void Chunk::RenderOpaqueMesh(const Camera& camera, const SkyBox& skybox) {
+    bool uniformsSet = false;
+
+    for(auto& sectionMesh : m_SectionMeshes) {
+        if(sectionMesh.Opaque.GetIndexCount() == 0) {
+            continue;
+        }
+
+        if(!uniformsSet) {
+            SetMeshUniforms(camera, skybox);
+            uniformsSet = true;
+        }
 
         // bind solid mesh
-        m_OpaqueMesh.Bind();
+        sectionMesh.Opaque.Bind();
 
-        // draw chunk
-        glDrawElements(GL_TRIANGLES, m_OpaqueMesh.GetIndexCount(), GL_UNSIGNED_INT, 0);
+        // draw section
+        glDrawElements(GL_TRIANGLES, sectionMesh.Opaque.GetIndexCount(), GL_UNSIGNED_INT, 0);
     }
 }
 
 void Chunk::RenderTranslucentMesh(const Camera& camera, const SkyBox& skybox) {
-    if(m_TranslucentMesh.GetIndexCount() > 0) {
-        // enable shader
-        m_Shader->Use();
-
-        // bind uniforms
-        m_Shader->SetMat4("u_Projection", camera.GetProjectionMatrix());
-        m_Shader->SetMat4("u_View", camera.GetViewMatrix());
-        m_Shader->SetMat4("u_Model", glm::translate(glm::mat4(1.0f), m_Position));
+    bool uniformsSet = false;
 
-        // bind lighting uniforms
-        m_Shader->SetVec3("u_SunDirection", skybox.GetSunDirection());
-        m_Shader->SetVec3("u_SunColor", skybox.GetSunColor());
-        m_Shader->SetVec3("u_AmbientColor", skybox.GetAmbientColor());
+    for(auto& sectionMesh : m_SectionMeshes) {
+        if(sectionMesh.Translucent.GetIndexCount() == 0) {
+            continue;
+        }
 
-        // bind texture atlas
-        m_TextureAtlas->GetTexture()->Bind();
+        if(!uniformsSet) {
+            SetMeshUniforms(camera, skybox);
+            uniformsSet = true;
+        }
 
         // bind water mesh
-        m_TranslucentMesh.Bind();
+        sectionMesh.Translucent.Bind();
 
         // draw water
-        glDrawElements(GL_TRIANGLES, m_TranslucentMesh.GetIndexCount(), GL_UNSIGNED_INT, 0);
+        glDrawElements(GL_TRIANGLES, sectionMesh.Translucent.GetIndexCount(), GL_UNSIGNED_INT, 0);
     }
 }
 
+void Chunk::SetMeshUniforms(const Camera& camera, const SkyBox& skybox) {
+    // enable shader
+    m_Shader->Use();
+
+    // bind uniforms
+    m_Shader->SetMat4("u_Projection", camera.GetProjectionMatrix());
+    m_Shader->SetMat4("u_View", camera.GetViewMatrix());
+    m_Shader->SetMat4("u_Model", glm::translate(glm::mat4(1.0f), m_Position));
+
+    // bind lighting uniforms
+    m_Shader->SetVec3("u_SunDirection", skybox.GetSunDirection());
+    m_Shader->SetVec3("u_SunColor", skybox.GetSunColor());
+    m_Shader->SetVec3("u_AmbientColor", skybox.GetAmbientColor());
+
+    // distance fog
+    m_Shader->SetVec3("u_CameraPosition", camera.GetPosition());
+    m_Shader->SetFloat("u_FogStart", 160.0f);
+    m_Shader->SetFloat("u_FogEnd", 176.0f);
+
+    // bind texture atlas
+    m_Shader->SetVec2("u_TileSize", m_TextureAtlas->GetTileSize());
+    m_TextureAtlas->GetTexture()->Bind();
+}
+
 Intersects::AABB Chunk::GetBoundingBox() {
     return m_BoundingBox;
 }
@@ -302,6 +306,10 @@ Block Chunk::GetBlock(const glm::vec3& position) {
     return block;
 }
 
+glm::ivec2 Chunk::GetKey() {
+    return m_Key;
+}
+
 glm::vec3 Chunk::GetPosition() {
     return m_Position;
 }
@@ -316,81 +324,137 @@ void Chunk::SetPosition(const glm::vec3& position) {
 }
 
 bool Chunk::BlockInside(const glm::vec3& position) {
-    return (position.x >= 0 && position.x < m_BlockTypes.size() &&
-        position.y >= 0 && position.y < m_BlockTypes[0].size() &&
-        position.z >= 0 && position.z < m_BlockTypes[0][0].size());
+    return (position.x >= 0 && position.x < s_ChunkSize &&
+        position.y >= 0 && position.y < s_ChunkHeight &&
+        position.z >= 0 && position.z < s_ChunkSize);
 }
 
 BlockType Chunk::GetBlockType(const glm::vec3& position) {
-    if(position.x < 0 || position.x > m_BlockTypes.size() ||
-        position.y < 0 || position.y > m_BlockTypes[0].size() ||
-        position.z < 0 || position.z > m_BlockTypes[0][0].size()) {
+    if(!BlockInside(position)) {
         return BlockType::VOID;
     }
 
     glm::ivec3 pos = glm::ivec3(position);
-    return m_BlockTypes[pos.x][pos.y][pos.z];
+    return m_Sections[pos.y / s_ChunkSize].Get(GetBlockIndex(pos.x, pos.y, pos.z));
 }
 
 void Chunk::SetBlockType(const glm::vec3& position, const BlockType& type) {
     glm::ivec3 pos = glm::ivec3(position);
-    m_BlockTypes[pos.x][pos.y][pos.z] = type;
+    m_Sections[pos.y / s_ChunkSize].Set(GetBlockIndex(pos.x, pos.y, pos.z), type);
 }
 
 void Chunk::SetState(const ChunkState& state) {
-    m_State = state;
+    m_State.store(state, std::memory_order_release);
 }
 
 ChunkState Chunk::GetState() {
-    return m_State;
+    return m_State.load(std::memory_order_acquire);
+}
+
+bool Chunk::TransitionState(ChunkState from, ChunkState to) {
+    return m_State.compare_exchange_strong(from, to, std::memory_order_acq_rel);
+}
+
+void Chunk::AddDirtySections(uint32_t sections) {
+    m_DirtySections |= sections;
+}
+
+uint32_t Chunk::GetDirtySections() const {
+    return m_DirtySections;
+}
+
+void Chunk::ClearDirtySections() {
+    m_DirtySections = 0;
+}
+
+void Chunk::Serialize(std::vector<uint8_t>& data) const {
+    ChunkCodec::Encode(m_Sections, data);
+}
+
+bool Chunk::Deserialize(const uint8_t* data, size_t size) {
+    if(ChunkCodec::Decode(data, size, m_Sections)) {
+        return true;
+    }
+
+    // the chunk is generated instead, partly read sections would end up in it
+    for(auto& section : m_Sections) {
+        section.Reset();
+    }
+
+    return false;
+}
+
+const BlockStorage& Chunk::GetSection(int section) const {
+    return m_Sections[section];
+}
+
+bool Chunk::GetSectionType(int section, BlockType& type) {
+    // everything below and above the chunk is void
+    if(section < 0 || section >= s_SectionCount) {
+        type = BlockType::VOID;
+        return true;
+    }
+
+    if(!m_Sections[section].IsUniform()) {
+        return false;
+    }
+
+    type = m_Sections[section].Get(0);
+    return true;
+}
+
+size_t Chunk::GetMemoryUsage() const {
+    size_t memory = sizeof(Chunk);
+
+    for(const auto& section : m_Sections) {
+        memory += section.GetMemoryUsage();
+    }
+
+    return memory;
+}
+
+size_t Chunk::GetBlockIndex(int x, int y, int z) {
+    // y-major layout inside a section keeps horizontal slices contiguous
+    return (static_cast<size_t>(y % s_ChunkSize) * s_ChunkSize + z) * s_ChunkSize + x;
+}
+
+void Chunk::CompactSections() {
+    for(auto& section : m_Sections) {
+        section.Compact();
+    }
 }
 
 void Chunk::PlaceTree(const glm::vec3& position) {
     for(const auto& treeBlock : s_Tree) {
         glm::vec3 treeBlockPosition = position + treeBlock.Position;
 
+        // parts outside of the chunk are placed by the neighbor chunk
         if(BlockInside(treeBlockPosition)) {
             SetBlockType(treeBlockPosition, treeBlock.Type);
-        } else {
-            Block block = m_ChunkManager->GetBlock(m_Position + treeBlockPosition);
-            
-            block.Type = treeBlock.Type;
-
-            m_ChunkManager->CreateBlock(block);
         }
     }
 }
 
 bool Chunk::FaceVisible(BlockType current, BlockType neighbor) {
-    if(current == BlockType::AIR) {
+    const BlockInfo& info = BlockRegistry::Get(current);
+
+    if(!info.Visible) {
         return false;
     }
 
-    if(current == BlockType::WATER) {
-        return neighbor != BlockType::WATER && neighbor != BlockType::VOID;
+    if(info.Liquid) {
+        return neighbor != current && neighbor != BlockType::VOID;
     }
 
-    return neighbor == BlockType::AIR || neighbor == BlockType::WATER || neighbor == BlockType::LEAVES || neighbor == BlockType::GLASS;
+    return !BlockRegistry::Get(neighbor).Opaque;
 }
 
-uint8_t Chunk::CreateVertexAO(const glm::vec3& position, const Direction& direction, const size_t& vertex) {
-    std::vector<glm::vec3> neighbors = m_VertexNeighbors[vertex][direction];
+uint8_t Chunk::CreateVertexAO(const ChunkSnapshot& snapshot, const glm::vec3& position, const Direction& direction, const size_t& vertex) {
+    const VertexNeighbors& neighbors = s_VertexNeighbors[direction][vertex];
     std::array<bool, 3> solid = { false };
 
     for(size_t i = 0; i < 3; i++) {
-        glm::vec3 neighborPosition = position + neighbors[i];
-
-        Block block;
-        
-        if(BlockInside(neighborPosition)) {
-            block = GetBlock(neighborPosition);
-        } else {
-            block = m_ChunkManager->GetBlock(m_Position + neighborPosition);
-        }
-
-        if(block.Type != BlockType::AIR && block.Type != BlockType::WATER && block.Type != BlockType::LEAVES) {
-            solid[i] = true;
-        }
+        solid[i] = BlockRegistry::Get(snapshot.Get(position + neighbors.Neighbors[i])).Occludes;
     }
 
     if(solid[0] && solid[1]) {
@@ -406,10 +470,8 @@ uint8_t Chunk::CreateVertexAO(const glm::vec3& position, const Direction& direct
     return 3 - occlusion;
 }
 
-BlockMesh Chunk::CreateBlockMesh(const glm::vec3& position, const BlockType& type) {
-    BlockMesh block;
-
-    block.Type = type;
+FaceMesh Chunk::CreateFaceMesh(const ChunkSnapshot& snapshot, const glm::vec3& position, const BlockType& type, size_t face) {
+    FaceMesh faceMesh;
 
     const glm::vec3 directions[6] = {
         {  0,  0,  1 }, // front
@@ -420,97 +482,245 @@ BlockMesh Chunk::CreateBlockMesh(const glm::vec3& position, const BlockType& typ
         {  0, -1,  0 } // bottom
     };
 
+    glm::vec3 n = directions[face];
+
+    if(!FaceVisible(type, snapshot.Get(position + n))) {
+        return faceMesh;
+    }
+
+    const Face& f = s_Faces[face];
+
+    faceMesh.Tile = BlockRegistry::Get(type).Tiles[face];
+
+    // ambient occlusion
+    for(size_t i = 0; i < 4; i++) {
+        faceMesh.AO[i] = CreateVertexAO(snapshot, position + n, f.Direction, i);
+    }
+
+    faceMesh.Visible = true;
+
+    return faceMesh;
+}
+
+void Chunk::AddBlockMesh(const ChunkSnapshot& snapshot, const glm::vec3& position, const BlockType& type, int section) {
+    MeshConfig& config = GetMeshConfig(section, type);
+
+    // corners of a single block face, the shader repeats the atlas tile per unit
+    const glm::ivec2 uvs[4] = {
+        { 0, 1 },
+        { 1, 1 },
+        { 1, 0 },
+        { 0, 0 }
+    };
+
     for(size_t face = 0; face < 6; face++) {
-        glm::vec3 n = directions[face];
-        
-        Block neighbor;
-
-        if(BlockInside(position + n)) {
-            neighbor = GetBlock(position + n);
-        } else {
-            neighbor = m_ChunkManager->GetBlock(m_Position + position + n);
-        }
+        FaceMesh faceMesh = CreateFaceMesh(snapshot, position, type, face);
 
-        if(!FaceVisible(block.Type, neighbor.Type)) {
+        if(!faceMesh.Visible) {
             continue;
         }
 
         const Face& f = s_Faces[face];
 
-        glm::ivec2 tile = { 0, 0 };
+        Renderer::ChunkVertex vertices[4];
+
+        for(size_t i = 0; i < 4; i++) {
+            // face corners are half a block off the block center, packed positions are whole block corners
+            glm::ivec3 corner = glm::ivec3(position + f.Vertices[i] + 0.5f);
 
-        if(m_BlockTypesUVsMap[Direction::ALL].contains(block.Type)) {
-            tile = m_BlockTypesUVsMap[Direction::ALL][block.Type];
-        } else {
-            tile = m_BlockTypesUVsMap[f.Direction][block.Type];
+            vertices[i] = Renderer::ChunkVertex::Pack(corner, static_cast<uint32_t>(face), faceMesh.AO[i], faceMesh.Tile, uvs[i]);
         }
 
-        std::vector<glm::vec2> uvs = m_TextureAtlas->GetTileUV(tile.x, tile.y);
+        AddQuad(config, vertices);
+    }
+}
 
-        for(size_t i = 0; i < 4; i++) {
-            Renderer::Vertex v;
-            
-            // position
-            v.Position = position + f.Vertices[i];
+void Chunk::BuildNaiveSectionMesh(const ChunkSnapshot& snapshot, int section) {
+    // walk blocks in storage order (y, z, x)
+    for(int y = section * s_ChunkSize; y < (section + 1) * s_ChunkSize; y++) {
+        for(int z = 0; z < s_ChunkSize; z++) {
+            for(int x = 0; x < s_ChunkSize; x++) {
+                BlockType type = snapshot.Get(x, y, z);
+
+                if(type == BlockType::AIR)
+                    continue;
+
+                AddBlockMesh(snapshot, glm::vec3(x, y, z), type, section);
+            }
+        }
+    }
+}
 
-            // uvs
-            v.UVs = uvs[i];
+void Chunk::BuildGreedySectionMesh(const ChunkSnapshot& snapshot, int section) {
+    const int sectionY = section * s_ChunkSize;
 
-            // noraml
-            v.Normal = f.Normal;
+    // for every face: axis of the normal, and axes/signs of the v0->v1 and v0->v3 quad edges
+    struct FaceAxes {
+        int Normal;
+        int U;
+        int USign;
+        int V;
+        int VSign;
+    };
 
-            // ambient occlusion
-            v.AO = CreateVertexAO(position + n, f.Direction, i);
+    const FaceAxes faceAxes[6] = {
+        { 2, 0,  1, 1,  1 }, // front
+        { 2, 0, -1, 1,  1 }, // back
+        { 0, 2,  1, 1,  1 }, // left
+        { 0, 2, -1, 1,  1 }, // right
+        { 1, 0,  1, 2, -1 }, // top
+        { 1, 0,  1, 2,  1 }  // bottom
+    };
 
-            block.Vertices.push_back(v);
-        }
+    struct Cell {
+        BlockType Type = BlockType::AIR;
+        FaceMesh Face;
+    };
+
+    // only faces with flat ambient occlusion are merged, so shading matches the naive mesh
+    auto sameCell = [](const Cell& a, const Cell& b) {
+        bool flatAO = a.Face.AO[0] == a.Face.AO[1] && a.Face.AO[1] == a.Face.AO[2] && a.Face.AO[2] == a.Face.AO[3];
+
+        return flatAO && a.Face.Visible && b.Face.Visible &&
+            a.Type == b.Type &&
+            a.Face.Tile == b.Face.Tile &&
+            std::equal(std::begin(a.Face.AO), std::end(a.Face.AO), std::begin(b.Face.AO));
+    };
+
+    std::array<Cell, s_ChunkSize * s_ChunkSize> mask;
+
+    for(size_t face = 0; face < 6; face++) {
+        const Face& f = s_Faces[face];
+        const FaceAxes& axes = faceAxes[face];
+
+        for(int slice = 0; slice < s_ChunkSize; slice++) {
+            // collect visible faces of the slice
+            for(int v = 0; v < s_ChunkSize; v++) {
+                for(int u = 0; u < s_ChunkSize; u++) {
+                    glm::ivec3 local(0);
+                    local[axes.Normal] = slice;
+                    local[axes.U] = u;
+                    local[axes.V] = v;
+
+                    Cell& cell = mask[v * s_ChunkSize + u];
+
+                    cell.Type = snapshot.Get(local.x, local.y + sectionY, local.z);
+                    cell.Face = FaceMesh();
+
+                    if(cell.Type == BlockType::AIR) {
+                        continue;
+                    }
+
+                    glm::vec3 position = glm::vec3(local.x, local.y + sectionY, local.z);
+                    cell.Face = CreateFaceMesh(snapshot, position, cell.Type, face);
+                }
+            }
+
+            // merge equal faces into rectangles
+            for(int v = 0; v < s_ChunkSize; v++) {
+                for(int u = 0; u < s_ChunkSize;) {
+                    const Cell cell = mask[v * s_ChunkSize + u];
+
+                    if(!cell.Face.Visible) {
+                        u++;
+                        continue;
+                    }
+
+                    int width = 1;
+
+                    while(u + width < s_ChunkSize && sameCell(cell, mask[v * s_ChunkSize + u + width])) {
+                        width++;
+                    }
+
+                    int height = 1;
+
+                    while(v + height < s_ChunkSize) {
+                        bool rowMatches = true;
+
+                        for(int k = 0; k < width; k++) {
+                            if(!sameCell(cell, mask[(v + height) * s_ChunkSize + u + k])) {
+                                rowMatches = false;
+                                break;
+                            }
+                        }
+
+                        if(!rowMatches) {
+                            break;
+                        }
+
+                        height++;
+                    }
+
+                    for(int dv = 0; dv < height; dv++) {
+                        for(int du = 0; du < width; du++) {
+                            mask[(v + dv) * s_ChunkSize + u + du].Face.Visible = false;
+                        }
+                    }
+
+                    // pick the block whose face vertex becomes the quad corner
+                    int uFirst = axes.USign > 0 ? u : u + width - 1;
+                    int uLast = axes.USign > 0 ? u + width - 1 : u;
+                    int vFirst = axes.VSign > 0 ? v : v + height - 1;
+                    int vLast = axes.VSign > 0 ? v + height - 1 : v;
+
+                    const glm::ivec2 corners[4] = {
+                        { uFirst, vFirst },
+                        { uLast, vFirst },
+                        { uLast, vLast },
+                        { uFirst, vLast }
+                    };
+
+                    const glm::ivec2 uvs[4] = {
+                        { 0, height },
+                        { width, height },
+                        { width, 0 },
+                        { 0, 0 }
+                    };
+
+                    Renderer::ChunkVertex vertices[4];
+
+                    for(size_t i = 0; i < 4; i++) {
+                        glm::ivec3 local(0);
+                        local[axes.Normal] = slice;
+                        local[axes.U] = corners[i].x;
+                        local[axes.V] = corners[i].y;
+
+                        // face corners are half a block off the block center, packed positions are whole block corners
+                        glm::ivec3 corner = glm::ivec3(glm::vec3(local.x, local.y + sectionY, local.z) + f.Vertices[i] + 0.5f);
+
+                        vertices[i] = Renderer::ChunkVertex::Pack(corner, static_cast<uint32_t>(face), cell.Face.AO[i], cell.Face.Tile, uvs[i]);
+                    }
 
-        // Add indices
-        block.Indices.push_back(block.IndexOffset + 0);
-        block.Indices.push_back(block.IndexOffset + 1);
-        block.Indices.push_back(block.IndexOffset + 2);
-        block.Indices.push_back(block.IndexOffset + 2);
-        block.Indices.push_back(block.IndexOffset + 3);
-        block.Indices.push_back(block.IndexOffset + 0);
+                    AddQuad(GetMeshConfig(section, cell.Type), vertices);
 
-        block.IndexOffset += 4;
+                    u += width;
+                }
+            }
+        }
+    }
+}
 
-        block.Visible = true;
+MeshConfig& Chunk::GetMeshConfig(int section, BlockType type) {
+    if(BlockRegistry::Get(type).Translucent) {
+        return m_MeshStaging->Translucent[section];
     }
 
-    return block;
+    return m_MeshStaging->Opaque[section];
 }
 
-std::array<float, Chunk::s_ChunkSize * Chunk::s_ChunkSize> Chunk::CreateHeightMap(const Perlin& perlin,
-                                                                                  const float& scale,
-                                                                                  const int& octaves,
-                                                                                  const float& persistence) {
+void Chunk::AddQuad(MeshConfig& config, const Renderer::ChunkVertex vertices[4]) {
+    config.Vertices.insert(config.Vertices.end(), vertices, vertices + 4);
+}
+
+std::array<float, Chunk::s_ChunkSize * Chunk::s_ChunkSize> Chunk::CreateHeightMap(const WorldGenerator& generator) {
     std::array<float, Chunk::s_ChunkSize * Chunk::s_ChunkSize> heightMap = { 0.0f };
     glm::ivec2 chunkOffset = { m_Position.x, m_Position.z }; // y - is height of a chunk
 
     for(int y = 0; y < s_ChunkSize; y++) {
         for(int x = 0; x < s_ChunkSize; x++) {
-            double amplitude = 1.0;
-            double freequency = 1.0;
-            double noiseValue = 0.0;
-
-            for(int o = 0; o < octaves; o++) {
-                noiseValue += amplitude * perlin.Noise(
-                    (chunkOffset.x + x) * scale * freequency,
-                    (chunkOffset.y + y) * scale * freequency,
-                    0.0
-                );
-
-                amplitude *= persistence;
-                freequency *= 2.0;
-            }
-
-            // normalize to [0, 1]
-            noiseValue = (noiseValue + 1.0) / 2.0;
-
-            heightMap[y * s_ChunkSize + x] = (float)noiseValue;
+            heightMap[y * s_ChunkSize + x] = generator.GetTerrainNoise(chunkOffset.x + x, chunkOffset.y + y);
         }
     }
 
     return heightMap;
-}
\ No newline at end of file
+}
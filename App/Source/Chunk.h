@@ -6,29 +6,17 @@
 #include "Core/Renderer/TextureAtlas.h"
 
 #include "Camera.h"
-#include "Perlin.h"
+#include "BlockType.h"
+#include "BlockRegistry.h"
+#include "BlockStorage.h"
+#include "WorldGenerator.h"
 #include "SkyBox.h"
 #include "Intersects.h"
 
 #include <glm/glm.hpp>
 
+#include <atomic>
 #include <memory>
-#include <unordered_map>
-
-enum BlockType {
-    VOID,
-    AIR,
-    STONE,
-    DIRT,
-    GRASS,
-    WATER,
-    SAND,
-    WOOD,
-    LEAVES,
-    COBBLESTONE,
-    PLANKS,
-    GLASS
-};
 
 enum Direction {
     FRONT = 0,
@@ -40,15 +28,21 @@ enum Direction {
     ALL
 };
 
-struct BlockMesh {
-    BlockType Type = BlockType::AIR;
+enum MeshingMode {
+    NAIVE,
+    GREEDY
+};
 
+struct FaceMesh {
     bool Visible = false;
 
-    std::vector<Renderer::Vertex> Vertices;
-    std::vector<uint32_t> Indices;
+    glm::ivec2 Tile = { 0, 0 };
+    uint8_t AO[4] = { 0, 0, 0, 0 };
+};
 
-    int IndexOffset = 0;
+struct MeshConfig {
+    // 4 vertices per quad, indices come from the shared quad index buffer
+    std::vector<Renderer::ChunkVertex> Vertices;
 };
 
 struct Face {
@@ -163,8 +157,58 @@ struct VertexNeighbors {
     glm::vec3 Neighbors[3];
 };
 
+// blocks around a face vertex that darken it: the two edge neighbors, then the corner
+// indexed by face direction and vertex
+inline constexpr VertexNeighbors s_VertexNeighbors[6][4] = {
+    // front
+    {
+        { { {  0, -1,  0 }, { -1,  0,  0 }, { -1, -1,  0 } } },
+        { { {  0, -1,  0 }, { +1,  0,  0 }, { +1, -1,  0 } } },
+        { { {  0, +1,  0 }, { +1,  0,  0 }, { +1, +1,  0 } } },
+        { { {  0, +1,  0 }, { -1,  0,  0 }, { -1, +1,  0 } } },
+    },
+    // back
+    {
+        { { {  0, -1,  0 }, { +1,  0,  0 }, { +1, -1,  0 } } },
+        { { {  0, -1,  0 }, { -1,  0,  0 }, { -1, -1,  0 } } },
+        { { {  0, +1,  0 }, { -1,  0,  0 }, { -1, +1,  0 } } },
+        { { {  0, +1,  0 }, { +1,  0,  0 }, { +1, +1,  0 } } },
+    },
+    // left
+    {
+        { { {  0, -1,  0 }, {  0,  0, -1 }, {  0, -1, -1 } } },
+        { { {  0, -1,  0 }, {  0,  0, +1 }, {  0, -1, +1 } } },
+        { { {  0, +1,  0 }, {  0,  0, +1 }, {  0, +1, +1 } } },
+        { { {  0, +1,  0 }, {  0,  0, -1 }, {  0, +1, -1 } } },
+    },
+    // right
+    {
+        { { {  0, -1,  0 }, {  0,  0, +1 }, {  0, -1, +1 } } },
+        { { {  0, -1,  0 }, {  0,  0, -1 }, {  0, -1, -1 } } },
+        { { {  0, +1,  0 }, {  0,  0, -1 }, {  0, +1, -1 } } },
+        { { {  0, +1,  0 }, {  0,  0, +1 }, {  0, +1, +1 } } },
+    },
+    // top
+    {
+        { { {  0,  0, +1 }, { -1,  0,  0 }, { -1,  0, +1 } } },
+        { { {  0,  0, +1 }, { +1,  0,  0 }, { +1,  0, +1 } } },
+        { { {  0,  0, -1 }, { +1,  0,  0 }, { +1,  0, -1 } } },
+        { { {  0,  0, -1 }, { -1,  0,  0 }, { -1,  0, -1 } } },
+    },
+    // bottom
+    {
+        { { {  0,  0, -1 }, { -1,  0,  0 }, { -1,  0, -1 } } },
+        { { {  0,  0, -1 }, { +1,  0,  0 }, { +1,  0, -1 } } },
+        { { {  0,  0, +1 }, { +1,  0,  0 }, { +1,  0, +1 } } },
+        { { {  0,  0, +1 }, { -1,  0,  0 }, { -1,  0, +1 } } },
+    },
+};
+
+// main thread: CREATED -> GENERATING, DECORATED/READY/LOADED -> MESHED, READY -> LOADED, any -> REMOVED
+// workers:     GENERATING -> GENERATED -> DECORATED, MESHED -> READY
 enum ChunkState {
     CREATED,
+    GENERATING, // queued for generation and decoration
     GENERATED,
     DECORATED,
     MESHED,
@@ -174,7 +218,9 @@ enum ChunkState {
 };
 
 class ChunkManager;
+class ChunkSnapshot;
 struct Block;
+struct ChunkMeshStaging;
 
 class Chunk {
 public:
@@ -184,13 +230,33 @@ public:
           const std::shared_ptr<Renderer::Shader>& shader);
     ~Chunk();
 
-    void Generate();
-    void GenerateDecorations();
+    // turns a removed chunk into an empty one at another position, reusing its memory
+    void Recycle(glm::ivec2 key);
+
+    // the generator is shared by every worker, it is only read
+    void Generate(const WorldGenerator& generator);
+    void GenerateDecorations(const WorldGenerator& generator);
 
     void ResetMesh();
-    void BuildMesh();
+    // releases the GPU storage of the meshes but keeps their GL objects
+    void ClearMesh();
+    // meshed with the chunk manager's current meshing mode
+    void BuildMesh(const ChunkSnapshot& snapshot);
+    void BuildSectionMesh(const ChunkSnapshot& snapshot, int section);
+    void BuildMesh(const ChunkSnapshot& snapshot, MeshingMode mode);
+    void BuildSectionMesh(const ChunkSnapshot& snapshot, int section, MeshingMode mode);
     void LoadMesh();
 
+    // buffers the mesh is built into, attached before meshing and given back to the chunk manager by LoadMesh
+    void SetMeshStaging(std::unique_ptr<ChunkMeshStaging> staging);
+    bool HasMeshStaging() const;
+    const ChunkMeshStaging* GetMeshStaging() const;
+
+    // bytes LoadMesh is going to upload
+    size_t GetMeshSize() const;
+    // bytes of the meshes on the GPU
+    size_t GetLoadedMeshSize();
+
     void RenderOpaqueMesh(const Camera& camera, const SkyBox& skybox);
     void RenderTranslucentMesh(const Camera& camera, const SkyBox& skybox);
 
@@ -199,6 +265,8 @@ public:
     Block GetBlock(const glm::vec3& position);
     bool BlockInside(const glm::vec3& position);
 
+    glm::ivec2 GetKey();
+
     glm::vec3 GetPosition();
     void SetPosition(const glm::vec3& position);
 
@@ -207,53 +275,92 @@ public:
 
     void SetState(const ChunkState& state);
     ChunkState GetState();
+
+    // changes the state only if it is still the expected one, so a worker never overrides REMOVED
+    bool TransitionState(ChunkState from, ChunkState to);
+
+    // sections edited since the last remesh, one bit per section, main thread only
+    void AddDirtySections(uint32_t sections);
+    uint32_t GetDirtySections() const;
+    void ClearDirtySections();
+
+    // blocks of every section in the chunk codec format, read back instead of generating the chunk again
+    void Serialize(std::vector<uint8_t>& data) const;
+    bool Deserialize(const uint8_t* data, size_t size);
+
+    const BlockStorage& GetSection(int section) const;
+    bool GetSectionType(int section, BlockType& type);
+
+    size_t GetMemoryUsage() const;
 public:
     bool Visible = false;
-    std::vector<glm::vec3> BlockVisible;
 
     static const int s_ChunkSize = 16;
+    static const int s_ChunkHeight = s_ChunkSize * s_ChunkSize;
+    static const int s_SectionCount = s_ChunkHeight / s_ChunkSize;
     static const int s_WaterLevel = 48;
+
+
+    static size_t GetBlockIndex(int x, int y, int z);
+    static bool FaceVisible(BlockType current, BlockType neighbor);
 private:
+    // every section is meshed and uploaded on its own, so an edit rebuilds 16x16x16 blocks
+    struct SectionMesh {
+        Renderer::Mesh Opaque;
+        Renderer::Mesh Translucent;
+    };
+
+    void CompactSections();
+
     void PlaceTree(const glm::vec3& position);
 
-    bool FaceVisible(BlockType current, BlockType neighbor);
+    uint8_t CreateVertexAO(const ChunkSnapshot& snapshot, const glm::vec3& position, const Direction& direction, const size_t& vertex);
 
-    uint8_t CreateVertexAO(const glm::vec3& position, const Direction& direction, const size_t& vertex);
+    FaceMesh CreateFaceMesh(const ChunkSnapshot& snapshot, const glm::vec3& position, const BlockType& type, size_t face);
+    void AddBlockMesh(const ChunkSnapshot& snapshot, const glm::vec3& position, const BlockType& type, int section);
 
-    BlockMesh CreateBlockMesh(const glm::vec3& position, const BlockType& type);
+    void BuildNaiveSectionMesh(const ChunkSnapshot& snapshot, int section);
+    void BuildGreedySectionMesh(const ChunkSnapshot& snapshot, int section);
 
-    std::array<float, s_ChunkSize * s_ChunkSize> CreateHeightMap(const Perlin& perlin, 
-                                                                 const float& scale = 0.01f, 
-                                                                 const int& octaves = 4, 
-                                                                 const float& persistence = 0.5f);
+    MeshConfig& GetMeshConfig(int section, BlockType type);
+
+    void SetMeshUniforms(const Camera& camera, const SkyBox& skybox);
+    void AddQuad(MeshConfig& config, const Renderer::ChunkVertex vertices[4]);
+
+    std::array<float, s_ChunkSize * s_ChunkSize> CreateHeightMap(const WorldGenerator& generator);
 private:
-    ChunkState m_State = ChunkState::CREATED;
+    std::atomic<ChunkState> m_State = ChunkState::CREATED;
 
     glm::ivec2 m_Key;
     glm::vec3 m_Position;
 
     ChunkManager* m_ChunkManager;
 
-    struct MeshConfig {
-        std::vector<Renderer::Vertex> Vertices;
-        std::vector<uint32_t> Indices;
-        uint32_t IndexOffset = 0;
-    };
+    std::array<SectionMesh, s_SectionCount> m_SectionMeshes;
+    std::unique_ptr<ChunkMeshStaging> m_MeshStaging;
 
-    MeshConfig m_OpaqueMeshConfig;
-    MeshConfig m_TranslucentMeshConfig;
-
-    Renderer::Mesh m_OpaqueMesh;
-    Renderer::Mesh m_TranslucentMesh;
+    uint32_t m_DirtySections = 0;
 
     std::shared_ptr<Renderer::TextureAtlas> m_TextureAtlas;
     std::shared_ptr<Renderer::Shader> m_Shader;
 
-    std::unordered_map<BlockType, glm::ivec2> m_BlockTypesUVsMap[7];
-    std::unordered_map<Direction, std::vector<glm::vec3>> m_VertexNeighbors[4];
 
-    std::array<std::array<std::array<BlockType, s_ChunkSize>, s_ChunkSize * s_ChunkSize>, s_ChunkSize> m_BlockTypes{};
+    // 16x16x16 sections stacked from the bottom of the chunk
+    std::vector<BlockStorage> m_Sections = std::vector<BlockStorage>(s_SectionCount, BlockStorage(s_ChunkSize * s_ChunkSize * s_ChunkSize));
     Intersects::AABB m_BoundingBox;
 
     std::array<float, s_ChunkSize * s_ChunkSize> m_HeightMap = { 0.0f };
 };
+
+// CPU side of a chunk mesh, from meshing until upload. The chunk manager recycles these
+// and the vectors keep their capacity, so meshing stops allocating once they have grown.
+struct ChunkMeshStaging {
+    std::array<MeshConfig, Chunk::s_SectionCount> Opaque;
+    std::array<MeshConfig, Chunk::s_SectionCount> Translucent;
+
+    // sections built since the last upload, one bit per section
+    uint32_t SectionsBuilt = 0;
+
+    // empties the buffers, their capacity is kept
+    void Clear();
+};
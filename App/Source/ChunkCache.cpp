@@ -0,0 +1,106 @@
+#include "ChunkCache.h"
+
+ChunkCache::ChunkCache(size_t memoryBudget, float meshGracePeriod)
+    : m_MeshGracePeriod(meshGracePeriod) {
+    m_MemoryBudget = memoryBudget;
+}
+
+ChunkCache::~ChunkCache() {
+}
+
+void ChunkCache::Insert(const std::shared_ptr<Chunk>& chunk, ChunkState state) {
+    uint64_t key = GetKey(chunk->GetKey());
+
+    // a chunk is cached once, a stale entry at the same position is replaced
+    if(auto it = m_Index.find(key); it != m_Index.end()) {
+        m_Memory -= it->second->Memory;
+        m_Entries.erase(it->second);
+        m_Index.erase(it);
+    }
+
+    Entry entry;
+
+    entry.Chunk = chunk;
+    entry.State = state;
+    entry.Time = Clock::now();
+    entry.Memory = chunk->GetMemoryUsage() + chunk->GetLoadedMeshSize();
+
+    m_Memory += entry.Memory;
+
+    m_Entries.push_front(std::move(entry));
+    m_Index[key] = m_Entries.begin();
+}
+
+std::shared_ptr<Chunk> ChunkCache::Remove(glm::ivec2 key, ChunkState& state) {
+    auto it = m_Index.find(GetKey(key));
+
+    if(it == m_Index.end()) {
+        m_Misses++;
+        return nullptr;
+    }
+
+    Entry& entry = *it->second;
+
+    std::shared_ptr<Chunk> chunk = std::move(entry.Chunk);
+    state = entry.State;
+
+    m_Memory -= entry.Memory;
+    m_Entries.erase(it->second);
+    m_Index.erase(it);
+
+    m_Hits++;
+    return chunk;
+}
+
+void ChunkCache::Update(std::vector<std::shared_ptr<Chunk>>& evicted) {
+    Clock::time_point now = Clock::now();
+
+    // oldest entries are at the back, stop at the first one still in its grace period
+    for(auto it = m_Entries.rbegin(); it != m_Entries.rend(); ++it) {
+        if(now - it->Time < m_MeshGracePeriod) {
+            break;
+        }
+
+        if(it->State != ChunkState::LOADED) {
+            continue;
+        }
+
+        // blocks are kept, the chunk is meshed again when restored
+        it->Chunk->ClearMesh();
+        it->State = ChunkState::DECORATED;
+
+        m_Memory -= it->Memory;
+        it->Memory = it->Chunk->GetMemoryUsage();
+        m_Memory += it->Memory;
+    }
+
+    while(m_Memory > m_MemoryBudget && !m_Entries.empty()) {
+        Entry& entry = m_Entries.back();
+
+        m_Memory -= entry.Memory;
+        m_Index.erase(GetKey(entry.Chunk->GetKey()));
+
+        evicted.push_back(std::move(entry.Chunk));
+        m_Entries.pop_back();
+    }
+}
+
+size_t ChunkCache::GetCount() const {
+    return m_Entries.size();
+}
+
+size_t ChunkCache::GetMemoryUsage() const {
+    return m_Memory;
+}
+
+size_t ChunkCache::GetHits() const {
+    return m_Hits;
+}
+
+size_t ChunkCache::GetMisses() const {
+    return m_Misses;
+}
+
+uint64_t ChunkCache::GetKey(glm::ivec2 position) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(position.x)) << 32) | static_cast<uint32_t>(position.y);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Chunk.h"
+
+#include <glm/glm.hpp>
+
+#include <list>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <stdint.h>
+#include <unordered_map>
+
+// Least recently used cache of chunks that left the view distance. Chunks are
+// kept whole, blocks and GPU meshes, so walking back into an area restores
+// them without generating or meshing them again. Meshes are only kept for a
+// grace period, after that the chunk keeps its blocks and is meshed again on
+// restore. Chunks past the memory budget are evicted oldest first. The cache
+// is not synchronized, it is used from the main thread only.
+class ChunkCache {
+public:
+    // budget covers block data and GPU meshes, grace period is in seconds
+    ChunkCache(size_t memoryBudget, float meshGracePeriod);
+    ~ChunkCache();
+
+    // state is the one the chunk goes back to on restore, DECORATED or LOADED
+    void Insert(const std::shared_ptr<Chunk>& chunk, ChunkState state);
+    std::shared_ptr<Chunk> Remove(glm::ivec2 key, ChunkState& state);
+
+    // drops meshes past the grace period, chunks over the budget are moved to evicted
+    void Update(std::vector<std::shared_ptr<Chunk>>& evicted);
+
+    size_t GetCount() const;
+    size_t GetMemoryUsage() const;
+    size_t GetHits() const;
+    size_t GetMisses() const;
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::shared_ptr<Chunk> Chunk;
+        ChunkState State = ChunkState::DECORATED;
+        Clock::time_point Time;
+        size_t Memory = 0;
+    };
+
+    static uint64_t GetKey(glm::ivec2 position);
+private:
+    size_t m_MemoryBudget = 0;
+    std::chrono::duration<float> m_MeshGracePeriod;
+
+    // most recently removed chunks first
+    std::list<Entry> m_Entries;
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> m_Index;
+
+    size_t m_Memory = 0;
+
+    size_t m_Hits = 0;
+    size_t m_Misses = 0;
+};
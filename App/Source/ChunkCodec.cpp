@@ -0,0 +1,283 @@
+#include "ChunkCodec.h"
+
+#ifdef CRAFTMINE_ZLIB
+    #include <zlib.h>
+#endif
+
+#include <bit>
+#include <string.h>
+#include <iostream>
+
+#ifdef CRAFTMINE_ZLIB
+const bool ChunkCodec::s_CompressionAvailable = true;
+#else
+const bool ChunkCodec::s_CompressionAvailable = false;
+#endif
+
+void ChunkCodec::Encode(const std::vector<BlockStorage>& sections, std::vector<uint8_t>& data, bool compress) {
+    // version, flags
+    data.push_back(s_Version);
+    data.push_back(0);
+
+    size_t header = data.size();
+    std::vector<uint8_t> indices;
+
+    for(const auto& section : sections) {
+        EncodeSection(section, indices, data);
+    }
+
+#ifdef CRAFTMINE_ZLIB
+    if(!compress) {
+        return;
+    }
+
+    uLong bodySize = static_cast<uLong>(data.size() - header);
+    uLongf compressedSize = compressBound(bodySize);
+
+    std::vector<uint8_t> compressed(compressedSize);
+
+    if(compress2(compressed.data(), &compressedSize, data.data() + header, bodySize, s_DeflateLevel) != Z_OK) {
+        return;
+    }
+
+    // body size and the deflated body replace the body, when that is smaller
+    if(compressedSize + 4 >= bodySize) {
+        return;
+    }
+
+    data[header - 1] |= s_FlagDeflate;
+    data.resize(header);
+
+    for(int i = 0; i < 4; i++) {
+        data.push_back(static_cast<uint8_t>(bodySize >> (i * 8)));
+    }
+
+    data.insert(data.end(), compressed.begin(), compressed.begin() + compressedSize);
+#else
+    (void)compress;
+    (void)header;
+#endif
+}
+
+bool ChunkCodec::Decode(const uint8_t* data, size_t size, std::vector<BlockStorage>& sections) {
+    if(size == 0) {
+        return false;
+    }
+
+    const uint8_t* end = data + size;
+
+    if(data[0] == 1) {
+        const uint8_t* cursor = data + 1;
+
+        for(auto& section : sections) {
+            if(!section.Deserialize(cursor, end)) {
+                return false;
+            }
+        }
+
+        return cursor == end;
+    }
+
+    if(data[0] != s_Version || size < 2) {
+        return false;
+    }
+
+    uint8_t flags = data[1];
+    const uint8_t* cursor = data + 2;
+
+    // inflated body, only used for compressed data
+    std::vector<uint8_t> body;
+
+    if(flags & s_FlagDeflate) {
+#ifdef CRAFTMINE_ZLIB
+        if(end - cursor < 4) {
+            return false;
+        }
+
+        uLongf bodySize = 0;
+
+        for(int i = 0; i < 4; i++) {
+            bodySize |= static_cast<uLongf>(cursor[i]) << (i * 8);
+        }
+
+        cursor += 4;
+
+        // a section takes at most its palette, the run count, and a run of up to 3 bytes per block
+        size_t maxBodySize = 0;
+
+        for(const auto& section : sections) {
+            maxBodySize += 1 + 256 + 2 + section.GetSize() * 4;
+        }
+
+        if(bodySize > maxBodySize) {
+            return false;
+        }
+
+        body.resize(bodySize);
+
+        if(uncompress(body.data(), &bodySize, cursor, static_cast<uLong>(end - cursor)) != Z_OK || bodySize != body.size()) {
+            return false;
+        }
+
+        cursor = body.data();
+        end = body.data() + body.size();
+#else
+        std::cerr << "Chunk data is compressed, but zlib was not built in" << std::endl;
+        return false;
+#endif
+    }
+
+    std::vector<uint8_t> indices;
+
+    for(auto& section : sections) {
+        if(!DecodeSection(cursor, end, indices, section)) {
+            return false;
+        }
+    }
+
+    return cursor == end;
+}
+
+void ChunkCodec::EncodeSection(const BlockStorage& section, std::vector<uint8_t>& indices, std::vector<uint8_t>& data) {
+    const std::vector<BlockType>& palette = section.GetPalette();
+
+    // palette size, palette
+    data.push_back(static_cast<uint8_t>(palette.size() - 1));
+    data.insert(data.end(), palette.begin(), palette.end());
+
+    // a single type needs no indices
+    if(palette.size() == 1) {
+        return;
+    }
+
+    indices.resize(section.GetSize());
+    section.GetIndices(indices.data());
+
+    // run count, the index of every run, then every run length minus one as a varint
+    size_t countOffset = data.size();
+    data.resize(data.size() + 2);
+
+    uint16_t runCount = 0;
+
+    std::vector<uint8_t> lengths;
+
+    for(size_t i = 0; i < indices.size(); runCount++) {
+        size_t length = GetRunLength(indices.data() + i, indices.size() - i);
+
+        data.push_back(indices[i]);
+
+        for(size_t value = length - 1; ; value >>= 7) {
+            lengths.push_back(static_cast<uint8_t>((value & 0x7F) | (value >= 0x80 ? 0x80 : 0)));
+
+            if(value < 0x80) {
+                break;
+            }
+        }
+
+        i += length;
+    }
+
+    data[countOffset] = static_cast<uint8_t>(runCount);
+    data[countOffset + 1] = static_cast<uint8_t>(runCount >> 8);
+
+    data.insert(data.end(), lengths.begin(), lengths.end());
+}
+
+bool ChunkCodec::DecodeSection(const uint8_t*& cursor, const uint8_t* end, std::vector<uint8_t>& indices, BlockStorage& section) {
+    if(end - cursor < 1) {
+        return false;
+    }
+
+    size_t paletteSize = static_cast<size_t>(cursor[0]) + 1;
+    cursor++;
+
+    if(static_cast<size_t>(end - cursor) < paletteSize) {
+        return false;
+    }
+
+    std::vector<BlockType> palette(paletteSize);
+
+    for(size_t i = 0; i < paletteSize; i++) {
+        palette[i] = static_cast<BlockType>(cursor[i]);
+    }
+
+    cursor += paletteSize;
+
+    indices.assign(section.GetSize(), 0);
+
+    if(paletteSize > 1) {
+        if(end - cursor < 2) {
+            return false;
+        }
+
+        size_t runCount = cursor[0] | (static_cast<size_t>(cursor[1]) << 8);
+        cursor += 2;
+
+        if(static_cast<size_t>(end - cursor) < runCount) {
+            return false;
+        }
+
+        const uint8_t* runIndices = cursor;
+        cursor += runCount;
+
+        size_t position = 0;
+
+        for(size_t run = 0; run < runCount; run++) {
+            size_t length = 0;
+
+            // section sizes fit in 3 varint bytes, longer ones are damaged data
+            for(int shift = 0; ; shift += 7) {
+                if(cursor == end || shift > 14) {
+                    return false;
+                }
+
+                uint8_t byte = *cursor++;
+                length |= static_cast<size_t>(byte & 0x7F) << shift;
+
+                if(!(byte & 0x80)) {
+                    break;
+                }
+            }
+
+            length++;
+
+            if(length > indices.size() - position) {
+                return false;
+            }
+
+            memset(indices.data() + position, runIndices[run], length);
+            position += length;
+        }
+
+        if(position != indices.size()) {
+            return false;
+        }
+    }
+
+    return section.SetIndices(palette, indices.data());
+}
+
+size_t ChunkCodec::GetRunLength(const uint8_t* indices, size_t size) {
+    uint64_t pattern = indices[0] * 0x0101010101010101ull;
+    size_t length = 0;
+
+    // the first differing byte of a word is its lowest one on little-endian machines
+    if constexpr(std::endian::native == std::endian::little) {
+        while(length + 8 <= size) {
+            uint64_t word;
+            memcpy(&word, indices + length, sizeof(word));
+
+            if(uint64_t difference = word ^ pattern) {
+                return length + std::countr_zero(difference) / 8;
+            }
+
+            length += 8;
+        }
+    }
+
+    while(length < size && indices[length] == indices[0]) {
+        length++;
+    }
+
+    return length;
+}
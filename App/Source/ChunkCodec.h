@@ -0,0 +1,39 @@
+#pragma once
+
+#include "BlockStorage.h"
+
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+// Versioned binary format of a chunk's sections. Each section is written as
+// its palette followed by runs of palette indices in storage order, which is
+// y-major, so the horizontal layers generated terrain is made of collapse
+// into a few runs. The run indices and the run lengths are stored apart, and
+// a section is unpacked to one byte per block before it is scanned, so both
+// directions work on flat byte arrays. When zlib was built in, the encoded
+// sections also go through deflate if that makes them smaller. Version 1
+// data, the packed indices as they were in memory, can still be read.
+class ChunkCodec {
+public:
+    static void Encode(const std::vector<BlockStorage>& sections, std::vector<uint8_t>& data, bool compress = s_CompressionAvailable);
+
+    // sections keep their size, false if the data is not valid, sections may then be partly written
+    static bool Decode(const uint8_t* data, size_t size, std::vector<BlockStorage>& sections);
+public:
+    // bumped whenever the layout changes, older versions are decoded as long as they are listed in Decode
+    static const uint8_t s_Version = 2;
+
+    static const bool s_CompressionAvailable;
+private:
+    static void EncodeSection(const BlockStorage& section, std::vector<uint8_t>& indices, std::vector<uint8_t>& data);
+    static bool DecodeSection(const uint8_t*& cursor, const uint8_t* end, std::vector<uint8_t>& indices, BlockStorage& section);
+
+    // blocks equal to the first one, compared eight at a time
+    static size_t GetRunLength(const uint8_t* indices, size_t size);
+private:
+    static const uint8_t s_FlagDeflate = 1;
+
+    // deflate at its fastest level already gets most of the gain on runs this short
+    static const int s_DeflateLevel = 1;
+};
@@ -0,0 +1,201 @@
+#include "ChunkJobPool.h"
+#include "ChunkManager.h"
+
+ChunkJobPool::ChunkJobPool(size_t workerCount, const ExecuteFn& execute) {
+    m_Execute = execute;
+
+    workerCount = std::max<size_t>(workerCount, 1);
+
+    for(size_t i = 0; i < workerCount; i++) {
+        m_Workers.push_back(std::make_unique<Worker>());
+    }
+
+    for(size_t i = 0; i < workerCount; i++) {
+        m_Threads.emplace_back(&ChunkJobPool::Run, this, i);
+    }
+}
+
+ChunkJobPool::~ChunkJobPool() {
+    Stop();
+}
+
+void ChunkJobPool::Push(const ChunkJob& job) {
+    size_t index = m_NextWorker++ % m_Workers.size();
+
+    {
+        // counted before the job is visible, so the worker taking it never decrements below zero
+        std::lock_guard<std::mutex> lock(m_Workers[index]->Mutex);
+        m_Pending++;
+        m_Workers[index]->PushBack(ChunkJob(job));
+    }
+
+    {
+        // a worker that saw no pending jobs is waiting by the time this lock is taken, so it gets the signal
+        std::lock_guard<std::mutex> lock(m_SignalMutex);
+    }
+
+    m_Signal.notify_one();
+}
+
+void ChunkJobPool::Push(std::vector<ChunkJob>& jobs) {
+    if(jobs.empty()) {
+        return;
+    }
+
+    // jobs come sorted best first, dealt round-robin so every worker starts on one of the best; each share
+    // goes to the front of its deque in reverse, so owners take it in order ahead of older work and
+    // thieves take the worst jobs from the back
+    size_t workerCount = m_Workers.size();
+    size_t first = m_NextWorker.fetch_add(jobs.size());
+
+    for(size_t w = 0; w < workerCount && w < jobs.size(); w++) {
+        size_t index = (first + w) % workerCount;
+        size_t last = w + (jobs.size() - 1 - w) / workerCount * workerCount;
+
+        std::lock_guard<std::mutex> lock(m_Workers[index]->Mutex);
+
+        for(size_t i = last + workerCount; i > w; i -= workerCount) {
+            m_Pending++;
+            m_Workers[index]->PushFront(std::move(jobs[i - workerCount]));
+        }
+    }
+
+    // moved-from jobs hold no chunks or snapshots anymore
+    jobs.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(m_SignalMutex);
+    }
+
+    m_Signal.notify_all();
+}
+
+void ChunkJobPool::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_SignalMutex);
+        m_Running = false;
+    }
+
+    m_Signal.notify_all();
+
+    for(auto& thread : m_Threads) {
+        if(thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    m_Threads.clear();
+
+    // drop jobs nobody picked up
+    for(auto& worker : m_Workers) {
+        std::lock_guard<std::mutex> lock(worker->Mutex);
+        worker->Jobs.clear();
+        worker->First = 0;
+        worker->Count = 0;
+    }
+
+    m_Pending = 0;
+}
+
+size_t ChunkJobPool::GetWorkerCount() const {
+    return m_Workers.size();
+}
+
+size_t ChunkJobPool::GetPendingCount() const {
+    return m_Pending;
+}
+
+void ChunkJobPool::Run(size_t index) {
+    while(m_Running) {
+        ChunkJob job;
+
+        if(Pop(index, job) || Steal(index, job)) {
+            m_Execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_SignalMutex);
+        m_Signal.wait(lock, [this] { return m_Pending > 0 || !m_Running; });
+    }
+}
+
+bool ChunkJobPool::Pop(size_t index, ChunkJob& job) {
+    Worker& worker = *m_Workers[index];
+
+    std::lock_guard<std::mutex> lock(worker.Mutex);
+
+    if(worker.Count == 0) {
+        return false;
+    }
+
+    job = worker.PopFront();
+
+    m_Pending--;
+
+    return true;
+}
+
+bool ChunkJobPool::Steal(size_t index, ChunkJob& job) {
+    for(size_t i = 1; i < m_Workers.size(); i++) {
+        Worker& victim = *m_Workers[(index + i) % m_Workers.size()];
+
+        std::lock_guard<std::mutex> lock(victim.Mutex);
+
+        if(victim.Count == 0) {
+            continue;
+        }
+
+        job = victim.PopBack();
+
+        m_Pending--;
+
+        return true;
+    }
+
+    return false;
+}
+
+void ChunkJobPool::Worker::PushFront(ChunkJob&& job) {
+    if(Count == Jobs.size()) {
+        Grow();
+    }
+
+    First = (First + Jobs.size() - 1) % Jobs.size();
+    Jobs[First] = std::move(job);
+    Count++;
+}
+
+void ChunkJobPool::Worker::PushBack(ChunkJob&& job) {
+    if(Count == Jobs.size()) {
+        Grow();
+    }
+
+    Jobs[(First + Count) % Jobs.size()] = std::move(job);
+    Count++;
+}
+
+ChunkJob ChunkJobPool::Worker::PopFront() {
+    ChunkJob job = std::move(Jobs[First]);
+
+    First = (First + 1) % Jobs.size();
+    Count--;
+
+    return job;
+}
+
+ChunkJob ChunkJobPool::Worker::PopBack() {
+    Count--;
+
+    return std::move(Jobs[(First + Count) % Jobs.size()]);
+}
+
+void ChunkJobPool::Worker::Grow() {
+    std::vector<ChunkJob> jobs(std::max<size_t>(Jobs.size() * 2, 16));
+
+    for(size_t i = 0; i < Count; i++) {
+        jobs[i] = std::move(Jobs[(First + i) % Jobs.size()]);
+    }
+
+    Jobs = std::move(jobs);
+    First = 0;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+struct ChunkJob;
+
+// Pool of chunk workers. Every worker owns a deque of jobs: it takes work
+// from the front of its own deque and, once that runs dry, steals from the
+// back of the other workers' deques. Batches are pushed to the front in
+// priority order, so the back always holds the least urgent jobs.
+class ChunkJobPool {
+public:
+    using ExecuteFn = std::function<void(ChunkJob&)>;
+
+    ChunkJobPool(size_t workerCount, const ExecuteFn& execute);
+    ~ChunkJobPool();
+
+    void Push(const ChunkJob& job);
+
+    // jobs are moved to the workers, the vector is left empty and keeps its capacity
+    void Push(std::vector<ChunkJob>& jobs);
+
+    void Stop();
+
+    size_t GetWorkerCount() const;
+    size_t GetPendingCount() const;
+private:
+    // ring buffer that grows when full and never shrinks, so a warm pool queues jobs without allocating
+    struct Worker {
+        std::vector<ChunkJob> Jobs;
+        size_t First = 0;
+        size_t Count = 0;
+
+        std::mutex Mutex;
+
+        void PushFront(ChunkJob&& job);
+        void PushBack(ChunkJob&& job);
+        ChunkJob PopFront();
+        ChunkJob PopBack();
+        void Grow();
+    };
+
+    void Run(size_t index);
+
+    bool Pop(size_t index, ChunkJob& job);
+    bool Steal(size_t index, ChunkJob& job);
+private:
+    ExecuteFn m_Execute;
+
+    std::vector<std::unique_ptr<Worker>> m_Workers;
+    std::vector<std::thread> m_Threads;
+
+    std::atomic<bool> m_Running = true;
+    std::atomic<size_t> m_Pending = 0;
+    std::atomic<size_t> m_NextWorker = 0;
+
+    std::mutex m_SignalMutex;
+    std::condition_variable m_Signal;
+};
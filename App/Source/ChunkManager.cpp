@@ -1,32 +1,127 @@
 #include "ChunkManager.h"
 #include "Chunk.h"
 
+#include <bit>
 #include <print>
 
-ChunkManager::ChunkManager() {
+ChunkManager::ChunkManager(int radius, std::optional<uint32_t> seed)
+    : m_Chunks(radius), m_ChunkPool(s_ChunkPoolCapacity), m_ChunkCache(s_ChunkCacheBudget, s_ChunkCacheMeshGracePeriod), m_WorldStorage("World"), m_EditJournal("World/edits.journal"),
+      m_SnapshotPool(std::max<size_t>(std::thread::hardware_concurrency(), 1) * (s_JobsPerWorker + 1)) {
     m_TextureAtlas = std::make_shared<Renderer::TextureAtlas>("Textures/terrain.png", 16, 16);
     m_ChunkShader = std::make_shared<Renderer::Shader>("Shaders/ChunkVertex.glsl", "Shaders/ChunkFragment.glsl");
 
-    m_ChunkJobsWorker = std::thread(&ChunkManager::ChunkJobsWorker, this);
+    // saved chunks and journaled edits only fit the terrain of the seed they were made on
+    uint32_t worldSeed = 0;
+
+    if(m_WorldStorage.LoadSeed(worldSeed)) {
+        if(seed && *seed != worldSeed) {
+            std::println("World was created with seed {}, seed {} is ignored", worldSeed, *seed);
+        }
+    } else {
+        worldSeed = seed.value_or(s_DefaultSeed);
+        m_WorldStorage.SaveSeed(worldSeed);
+    }
+
+    m_WorldGenerator = std::make_unique<WorldGenerator>(worldSeed);
+
+    // one worker per hardware thread
+    size_t workerCount = std::thread::hardware_concurrency();
+
+    m_ChunkJobPool = std::make_unique<ChunkJobPool>(workerCount, [this](ChunkJob& job) { ExecuteChunkJob(job); });
 }
 
 ChunkManager::~ChunkManager() {
-    m_ChunkJobsWorkerRunning = false;
-    
-    m_ChunkJobsSignal.notify_all();
+    // workers must be joined before chunks and GL resources go away
+    m_ChunkJobPool->Stop();
 
-    if(m_ChunkJobsWorker.joinable()) {
-        m_ChunkJobsWorker.join();
-    }
+    // reads still in flight push their GENERATE jobs to the stopped pool, they go away with it
+    m_WorldStorage.WaitForLoads();
+
+    // every edit is in the journal already, only queued writes are left
+    m_EditJournal.Flush([this]() { return m_WorldStorage.FlushAll(); });
 }
 
 void ChunkManager::AddChunkJob(const ChunkJob& job) {
-    {
-        std::lock_guard<std::mutex> lock(m_ChunkJobsMutex);
-        m_ChunkJobs.push(job);
+    m_ScheduledJobs.push_back(job);
+}
+
+void ChunkManager::AddChunkJobs(const std::vector<ChunkJob>& jobs) {
+    m_ScheduledJobs.insert(m_ScheduledJobs.end(), jobs.begin(), jobs.end());
+}
+
+void ChunkManager::DispatchChunkJobs(const glm::vec3& cameraPosition, const Intersects::Frustum& frustum) {
+    // edits made since the last dispatch become one remesh job per chunk
+    ScheduleDirtyChunks();
+
+    // cancel jobs of destroyed chunks, their saves still have to be written
+    size_t cancelled = std::erase_if(m_ScheduledJobs, [](const ChunkJob& job) {
+        return job.Type != ChunkJobType::SAVE && job.Chunk->GetState() == ChunkState::REMOVED;
+    });
+
+    m_ChunkJobsCancelled += cancelled;
+
+    // top up the pool only to a few jobs per worker
+    size_t capacity = m_ChunkJobPool->GetWorkerCount() * s_JobsPerWorker;
+    size_t pending = m_ChunkJobPool->GetPendingCount();
+
+    if(m_ScheduledJobs.empty() || pending >= capacity) {
+        return;
     }
 
-    m_ChunkJobsSignal.notify_one();
+    size_t count = std::min(capacity - pending, m_ScheduledJobs.size());
+
+    // camera moves every frame, so jobs are re-scored right before picking the best ones
+    for(auto& job : m_ScheduledJobs) {
+        job.Priority = GetChunkJobPriority(job, cameraPosition, frustum);
+    }
+
+    std::partial_sort(m_ScheduledJobs.begin(), m_ScheduledJobs.begin() + count, m_ScheduledJobs.end(),
+                      [](const ChunkJob& a, const ChunkJob& b) { return a.Priority < b.Priority; });
+
+    std::vector<ChunkJob> jobs(m_ScheduledJobs.begin(), m_ScheduledJobs.begin() + count);
+    m_ScheduledJobs.erase(m_ScheduledJobs.begin(), m_ScheduledJobs.begin() + count);
+
+    // saved chunks picked in the same frame are submitted as one batch, first so the reads are in flight
+    // while the other jobs run
+    ChunkJob load = { ChunkJobType::LOAD };
+
+    std::erase_if(jobs, [this, &load](const ChunkJob& job) {
+        if(job.Type != ChunkJobType::GENERATE || !m_WorldStorage.Contains(job.Chunk->GetKey())) {
+            return false;
+        }
+
+        load.Batch.push_back(job.Chunk);
+        return true;
+    });
+
+    if(!load.Batch.empty()) {
+        load.Chunk = load.Batch.front();
+        jobs.insert(jobs.begin(), std::move(load));
+    }
+
+    // snapshot is taken as late as possible, so it sees the latest blocks
+    for(auto& job : jobs) {
+        if((job.Type == ChunkJobType::MESH || job.Type == ChunkJobType::REMESH) && !job.Chunk->HasMeshStaging()) {
+            job.Chunk->SetMeshStaging(AcquireMeshStaging());
+        }
+
+        if(job.Snapshot) {
+            continue;
+        }
+
+        if(job.Type == ChunkJobType::MESH) {
+            job.Snapshot = CreateSnapshot(job.Chunk->GetKey());
+        }
+
+        if(job.Type == ChunkJobType::REMESH) {
+            int firstSection = std::countr_zero(job.Sections);
+            int lastSection = 31 - std::countl_zero(job.Sections);
+
+            job.Snapshot = CreateSnapshot(job.Chunk->GetKey(), firstSection, lastSection);
+        }
+    }
+
+    m_ChunkJobPool->Push(jobs);
 }
 
 std::shared_ptr<Chunk> ChunkManager::CreateChunk(glm::ivec2 position) {
@@ -34,46 +129,166 @@ std::shared_ptr<Chunk> ChunkManager::CreateChunk(glm::ivec2 position) {
         return nullptr;
     }
 
-    std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>(this, position, m_TextureAtlas, m_ChunkShader);
-    chunk->SetPosition({ position.x * Chunk::s_ChunkSize, 0, position.y * Chunk::s_ChunkSize });
+    // a cached chunk comes back in the state it left, with its blocks and meshes
+    ChunkState cachedState = ChunkState::CREATED;
+    std::shared_ptr<Chunk> chunk = m_ChunkCache.Remove(position, cachedState);
+
+    if(chunk) {
+        chunk->SetState(cachedState);
+    } else {
+        chunk = m_ChunkPool.Acquire(position);
 
-    {
-        std::lock_guard<std::mutex> lock(m_ChunksMutex);
-        m_Chunks[position] = chunk;
+        if(!chunk) {
+            chunk = std::make_shared<Chunk>(this, position, m_TextureAtlas, m_ChunkShader);
+        }
+
+        chunk->SetPosition({ position.x * Chunk::s_ChunkSize, 0, position.y * Chunk::s_ChunkSize });
+    }
+
+    // a chunk left out of the store's range is evicted like a destroyed one
+    std::shared_ptr<Chunk> evicted = m_Chunks.Insert(chunk);
+
+    if(evicted) {
+        RetireChunk(std::move(evicted));
     }
 
     return chunk;
 }
 
 void ChunkManager::DestroyChunk(glm::ivec2 position) {
-    {
-        std::lock_guard<std::mutex> lock(m_ChunksMutex);
-        m_Chunks.erase(position);
+    std::shared_ptr<Chunk> chunk = m_Chunks.Remove(position);
+
+    if(chunk) {
+        RetireChunk(std::move(chunk));
+    }
+}
+
+void ChunkManager::UpdateChunkCache() {
+    std::vector<std::shared_ptr<Chunk>> evicted;
+    m_ChunkCache.Update(evicted);
+
+    for(auto& chunk : evicted) {
+        m_ChunkPool.Release(std::move(chunk));
+    }
+
+    // released chunks the workers are done with are pooled or freed every frame, not only on the next miss
+    m_ChunkPool.Collect();
+}
+
+void ChunkManager::SaveChunk(const std::shared_ptr<Chunk>& chunk) {
+    std::vector<uint8_t> data;
+    chunk->Serialize(data);
+
+    m_WorldStorage.Save(chunk->GetKey(), std::move(data));
+
+    // the saved blocks have the edits, new ones are replayed on top of them,
+    // the SAVE job writes the blocks before the journal file forgets the edits
+    m_EditJournal.Drop(chunk->GetKey());
+
+    AddChunkJob({ ChunkJobType::SAVE, chunk });
+}
+
+void ChunkManager::LoadChunks(const std::vector<std::shared_ptr<Chunk>>& chunks) {
+    std::vector<ChunkRead> reads;
+    auto loading = std::make_shared<std::vector<std::shared_ptr<Chunk>>>();
+
+    for(const auto& chunk : chunks) {
+        if(chunk->GetState() == ChunkState::REMOVED) {
+            m_ChunkJobsCancelled++;
+            continue;
+        }
+
+        reads.push_back({ chunk->GetKey() });
+        loading->push_back(chunk);
+    }
+
+    // every chunk is decoded by a worker as soon as its read completes, chunks that turned out not to be saved are generated
+    m_WorldStorage.Load(std::move(reads), [this, loading](size_t index, ChunkRead& read) {
+        ChunkJob job = { ChunkJobType::GENERATE, (*loading)[index] };
+
+        if(read.Found) {
+            job.Data = std::make_shared<std::vector<uint8_t>>(std::move(read.Data));
+        }
+
+        m_ChunkJobPool->Push(job);
+    });
+}
+
+void ChunkManager::ReplayEdits(Chunk& chunk) {
+    std::vector<BlockEdit> edits;
+    m_EditJournal.GetEdits(chunk.GetKey(), edits);
+
+    for(const auto& edit : edits) {
+        chunk.SetBlockType(glm::vec3(EditJournal::GetEditPosition(edit.Index)), edit.New);
+    }
+}
+
+void ChunkManager::RetireChunk(std::shared_ptr<Chunk> chunk) {
+    ChunkState state = chunk->GetState();
+
+    // a chunk with many edits is cheaper to load whole than to generate and replay,
+    // its blocks are complete once decorated and its edits are replayed
+    bool complete = state >= ChunkState::DECORATED && state != ChunkState::REMOVED;
+
+    if(complete && m_EditJournal.GetEditCount(chunk->GetKey()) >= s_MaxJournalEditsPerChunk) {
+        SaveChunk(chunk);
+    }
+
+    // jobs still holding the chunk check this state and skip it
+    chunk->SetState(ChunkState::REMOVED);
+
+    // workers never move a chunk out of these states, so no job can be working on it,
+    // a pending remesh would be lost on restore though
+    bool restorable = (state == ChunkState::DECORATED || state == ChunkState::LOADED) && chunk->GetDirtySections() == 0;
+
+    if(restorable) {
+        m_ChunkCache.Insert(chunk, state);
+    } else {
+        m_ChunkPool.Release(std::move(chunk));
     }
 }
 
 bool ChunkManager::ChunkExists(glm::ivec2 position) {
-    bool exists = false;
+    return m_Chunks.Contains(position);
+}
 
-    {
-        std::lock_guard<std::mutex> lock(m_ChunksMutex);
-        exists = m_Chunks.contains(position);
+bool ChunkManager::NeighborsDecorated(glm::ivec2 position) {
+    for(int z = -1; z <= 1; z++) {
+        for(int x = -1; x <= 1; x++) {
+            const std::shared_ptr<Chunk>& chunk = m_Chunks.Get(position + glm::ivec2(x, z));
+
+            if(!chunk) {
+                return false;
+            }
+
+            ChunkState state = chunk->GetState();
+
+            if(state < ChunkState::DECORATED || state == ChunkState::REMOVED) {
+                return false;
+            }
+        }
     }
 
-    return exists;
+    return true;
 }
 
-std::shared_ptr<Chunk> ChunkManager::GetChunk(glm::ivec2 position) {
-    std::shared_ptr<Chunk> chunk = nullptr;
+std::shared_ptr<ChunkSnapshot> ChunkManager::CreateSnapshot(glm::ivec2 position, int firstSection, int lastSection) {
+    std::array<std::shared_ptr<Chunk>, 9> chunks;
 
-    if(ChunkExists(position)) {
-        {
-            std::lock_guard<std::mutex> lock(m_ChunksMutex);
-            chunk = m_Chunks[position];
+    for(int z = -1; z <= 1; z++) {
+        for(int x = -1; x <= 1; x++) {
+            chunks[(z + 1) * 3 + (x + 1)] = m_Chunks.Get(position + glm::ivec2(x, z));
         }
     }
 
-    return chunk;
+    std::shared_ptr<ChunkSnapshot> snapshot = m_SnapshotPool.Acquire();
+    snapshot->Capture(chunks, firstSection, lastSection);
+
+    return snapshot;
+}
+
+const std::shared_ptr<Chunk>& ChunkManager::GetChunk(glm::ivec2 position) {
+    return m_Chunks.Get(position);
 }
 
 Block ChunkManager::GetBlock(glm::vec3 position) {
@@ -86,8 +301,13 @@ Block ChunkManager::GetBlock(glm::vec3 position) {
 
     glm::ivec2 chunk = { chunkPosition.x, chunkPosition.z };
 
-    if(ChunkExists(chunk)) {
-        block.Type = GetChunk(chunk)->GetBlockType(localPosition);
+    if(const std::shared_ptr<Chunk>& blockChunk = GetChunk(chunk)) {
+        // blocks of chunks still being generated are owned by a worker, they read as VOID until decorated
+        ChunkState state = blockChunk->GetState();
+
+        if(state >= ChunkState::DECORATED && state != ChunkState::REMOVED) {
+            block.Type = blockChunk->GetBlockType(localPosition);
+        }
     }
 
     block.Position = position;
@@ -98,52 +318,296 @@ Block ChunkManager::GetBlock(glm::vec3 position) {
 }
 
 void ChunkManager::CreateBlock(const Block& block) {
-    if(ChunkExists(block.Chunk)) {
-        GetChunk(block.Chunk)->SetBlockType(block.ChunkPosition, block.Type);
+    const std::shared_ptr<Chunk>& chunk = GetChunk(block.Chunk);
+
+    if(!chunk) {
+        return;
+    }
+
+    // blocks of chunks still being generated are owned by a worker
+    ChunkState state = chunk->GetState();
+
+    if(state < ChunkState::DECORATED || state == ChunkState::REMOVED) {
+        return;
+    }
+
+    BlockType oldType = chunk->GetBlockType(block.ChunkPosition);
+
+    if(oldType == block.Type) {
+        return;
+    }
+
+    chunk->SetBlockType(block.ChunkPosition, block.Type);
+
+    // the generator rebuilds everything else, so the edit is all that has to be saved
+    m_EditJournal.Append(block.Chunk, { EditJournal::GetEditIndex(glm::ivec3(block.ChunkPosition)), oldType, block.Type });
+
+    if(!m_JournalFlushQueued.exchange(true)) {
+        AddChunkJob({ ChunkJobType::SAVE, chunk });
     }
+
+    MarkBlockDirty(block.Position);
 }
 
-ChunkMapIterator ChunkManager::ChunksBegin() {
-    return m_Chunks.begin();
+void ChunkManager::MarkBlockDirty(const glm::vec3& position) {
+    // faces and ambient occlusion of every block next to the edited one (diagonals included)
+    // can change, so every section any of them is in is remeshed
+    uint32_t sections = 0;
+
+    for(int dy = -1; dy <= 1; dy++) {
+        int y = static_cast<int>(position.y) + dy;
+
+        if(y >= 0 && y < Chunk::s_ChunkHeight) {
+            sections |= 1u << (y / Chunk::s_ChunkSize);
+        }
+    }
+
+    if(sections == 0) {
+        return;
+    }
+
+    for(int dz = -1; dz <= 1; dz++) {
+        for(int dx = -1; dx <= 1; dx++) {
+            glm::ivec2 key = {
+                static_cast<int>(std::floor((position.x + dx) / Chunk::s_ChunkSize)),
+                static_cast<int>(std::floor((position.z + dz) / Chunk::s_ChunkSize))
+            };
+
+            const std::shared_ptr<Chunk>& chunk = m_Chunks.Get(key);
+
+            if(!chunk) {
+                continue;
+            }
+
+            if(chunk->GetDirtySections() == 0) {
+                m_DirtyChunks.push_back(chunk);
+            }
+
+            chunk->AddDirtySections(sections);
+        }
+    }
 }
 
-ChunkMapIterator ChunkManager::ChunksEnd() {
-    return m_Chunks.end();
+void ChunkManager::ScheduleDirtyChunks() {
+    std::erase_if(m_DirtyChunks, [this](const std::shared_ptr<Chunk>& chunk) {
+        // a mesh job in flight may have read the blocks before the edit, retry once it is done
+        if(chunk->GetState() == ChunkState::MESHED) {
+            return false;
+        }
+
+        // meshed chunks keep rendering their current mesh until the new sections are uploaded
+        if(chunk->TransitionState(ChunkState::LOADED, ChunkState::MESHED) || chunk->TransitionState(ChunkState::READY, ChunkState::MESHED)) {
+            ChunkJob job;
+
+            job.Type = ChunkJobType::REMESH;
+            job.Chunk = chunk;
+            job.Sections = chunk->GetDirtySections();
+
+            m_ScheduledJobs.push_back(job);
+        }
+
+        // chunks not meshed yet pick the edits up from their snapshot, removed ones are dropped
+        chunk->ClearDirtySections();
+
+        return true;
+    });
 }
 
-void ChunkManager::ChunkJobsWorker() {
-    while(m_ChunkJobsWorkerRunning) {
-        ChunkJob job;
+const WorldGenerator& ChunkManager::GetWorldGenerator() const {
+    return *m_WorldGenerator;
+}
 
+const ChunkStore& ChunkManager::GetChunks() const {
+    return m_Chunks;
+}
+
+const ChunkPool& ChunkManager::GetChunkPool() const {
+    return m_ChunkPool;
+}
+
+const ChunkCache& ChunkManager::GetChunkCache() const {
+    return m_ChunkCache;
+}
+
+size_t ChunkManager::GetMemoryUsage() {
+    size_t memory = 0;
+
+    for(const auto& chunk : m_Chunks) {
+        // blocks of chunks still being generated are owned by a worker
+        if(chunk->GetState() >= ChunkState::DECORATED) {
+            memory += chunk->GetMemoryUsage();
+        }
+    }
+
+    return memory;
+}
+
+MeshingMode ChunkManager::GetMeshingMode() const {
+    return m_MeshingMode;
+}
+
+void ChunkManager::SetMeshingMode(MeshingMode mode) {
+    m_MeshingMode = mode;
+}
+
+size_t ChunkManager::GetWorkerCount() const {
+    return m_ChunkJobPool->GetWorkerCount();
+}
+
+std::unique_ptr<ChunkMeshStaging> ChunkManager::AcquireMeshStaging() {
+    if(m_MeshStagingPool.empty()) {
+        return std::make_unique<ChunkMeshStaging>();
+    }
+
+    std::unique_ptr<ChunkMeshStaging> staging = std::move(m_MeshStagingPool.back());
+    m_MeshStagingPool.pop_back();
+
+    return staging;
+}
+
+void ChunkManager::ReleaseMeshStaging(std::unique_ptr<ChunkMeshStaging> staging) {
+    staging->Clear();
+
+    if(m_MeshStagingPool.size() < s_MaxPooledMeshStaging) {
+        m_MeshStagingPool.push_back(std::move(staging));
+    }
+}
+
+void ChunkManager::PrefetchChunks(glm::ivec2 center, int radius) {
+    m_WorldStorage.Prefetch(center, radius);
+}
+
+const char* ChunkManager::GetIOBackendName() const {
+    return m_WorldStorage.GetBackendName();
+}
+
+size_t ChunkManager::GetChunksLoaded() const {
+    return m_ChunksLoaded;
+}
+
+size_t ChunkManager::GetChunksGenerated() const {
+    return m_ChunksGenerated;
+}
+
+size_t ChunkManager::GetChunksMeshed() const {
+    return m_ChunksMeshed;
+}
+
+bool ChunkManager::PopMeshedChunk(std::shared_ptr<Chunk>& chunk) {
+    return m_MeshedChunks.Pop(chunk);
+}
+
+size_t ChunkManager::GetScheduledJobCount() const {
+    return m_ScheduledJobs.size();
+}
+
+size_t ChunkManager::GetChunkJobsCancelled() const {
+    return m_ChunkJobsCancelled;
+}
+
+float ChunkManager::GetChunkJobPriority(const ChunkJob& job, const glm::vec3& cameraPosition, const Intersects::Frustum& frustum) {
+    Intersects::AABB boundingBox = job.Chunk->GetBoundingBox();
+
+    glm::vec2 center = { (boundingBox.MinBound.x + boundingBox.MaxBound.x) * 0.5f, (boundingBox.MinBound.z + boundingBox.MaxBound.z) * 0.5f };
+    float distance = glm::length(center - glm::vec2(cameraPosition.x, cameraPosition.z));
+
+    if(!Intersects::AABBFrustum(frustum, boundingBox)) {
+        distance *= s_OutOfFrustumPenalty;
+    }
+
+    if(job.Type == ChunkJobType::REMESH) {
+        distance += s_RemeshPriorityOffset;
+    }
+
+    if(job.Type == ChunkJobType::SAVE) {
+        distance += s_SavePriorityOffset;
+    }
+
+    return distance;
+}
+
+void ChunkManager::ExecuteChunkJob(ChunkJob& job) {
+    // saves run whatever the chunk state is, their data was queued on the main thread
+    if(job.Type == ChunkJobType::SAVE) {
+        m_JournalFlushQueued = false;
+
+        // every queued chunk is written before the journal forgets the edits it has,
+        // a failed write keeps the chunk queued and its edits in the file
+        m_EditJournal.Flush([this]() { return m_WorldStorage.FlushAll(); });
+        return;
+    }
+
+    // the batch skips its destroyed chunks itself
+    if(job.Type == ChunkJobType::LOAD) {
+        LoadChunks(job.Batch);
+        return;
+    }
+
+    // chunk was destroyed after the job reached the pool
+    if(job.Chunk->GetState() == ChunkState::REMOVED) {
+        m_ChunkJobsCancelled++;
+        return;
+    }
+
+    switch(job.Type) {
+        case ChunkJobType::GENERATE:
         {
-            std::unique_lock<std::mutex> lock(m_ChunkJobsMutex);
-            m_ChunkJobsSignal.wait(lock, [this] { return !m_ChunkJobs.empty() || ! m_ChunkJobsWorkerRunning; });
+            // saved chunks come back as they were left, decorations included
+            if(job.Data && job.Chunk->Deserialize(job.Data->data(), job.Data->size())) {
+                m_ChunksLoaded++;
 
-            if(!m_ChunkJobsWorkerRunning) {
+                ReplayEdits(*job.Chunk);
+                job.Chunk->TransitionState(ChunkState::GENERATING, ChunkState::DECORATED);
                 break;
             }
 
-            job = m_ChunkJobs.front();
-            m_ChunkJobs.pop();
+            job.Chunk->Generate(*m_WorldGenerator);
+            m_ChunksGenerated++;
+
+            // decoration only reads the chunk itself, so it skips the scheduler
+            if(job.Chunk->TransitionState(ChunkState::GENERATING, ChunkState::GENERATED)) {
+                m_ChunkJobPool->Push({ ChunkJobType::DECORATE, job.Chunk });
+            }
+            break;
         }
-        
-        switch(job.Type) {
-            case ChunkJobType::GENERATE:
-            {
-                job.Chunk->Generate();
-                break;
+        case ChunkJobType::DECORATE:
+        {
+            job.Chunk->GenerateDecorations(*m_WorldGenerator);
+            ReplayEdits(*job.Chunk);
+
+            job.Chunk->TransitionState(ChunkState::GENERATED, ChunkState::DECORATED);
+            break;
+        }
+        case ChunkJobType::MESH:
+        {
+            job.Chunk->BuildMesh(*job.Snapshot);
+            m_SnapshotPool.Release(std::move(job.Snapshot));
+
+            if(job.Chunk->TransitionState(ChunkState::MESHED, ChunkState::READY)) {
+                m_MeshedChunks.Push(job.Chunk);
             }
-            case ChunkJobType::DECORATE:
-            {
-                job.Chunk->GenerateDecorations();
-                break;
+
+            m_ChunksMeshed++;
+            break;
+        }
+        case ChunkJobType::REMESH:
+        {
+            for(int section = 0; section < Chunk::s_SectionCount; section++) {
+                if(job.Sections & (1u << section)) {
+                    job.Chunk->BuildSectionMesh(*job.Snapshot, section);
+                }
             }
-            case ChunkJobType::MESH:
-            {
-                job.Chunk->BuildMesh();
-                job.Chunk->SetState(ChunkState::READY);
-                break;
+
+            m_SnapshotPool.Release(std::move(job.Snapshot));
+
+            if(job.Chunk->TransitionState(ChunkState::MESHED, ChunkState::READY)) {
+                m_MeshedChunks.Push(job.Chunk);
             }
+            break;
         }
+        case ChunkJobType::SAVE:
+        case ChunkJobType::LOAD:
+            // run before the removed check above
+            break;
     }
 }
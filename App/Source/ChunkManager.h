@@ -1,7 +1,17 @@
 #pragma once
 
-#include "Perlin.h"
+#include "WorldGenerator.h"
 #include "Chunk.h"
+#include "ChunkSnapshot.h"
+#include "ChunkSnapshotPool.h"
+#include "ChunkJobPool.h"
+#include "ChunkStore.h"
+#include "ChunkPool.h"
+#include "ChunkCache.h"
+#include "WorldStorage.h"
+#include "EditJournal.h"
+#include "MPSCQueue.h"
+#include "Intersects.h"
 
 #include "Core/Renderer/TextureAtlas.h"
 #include "Core/Renderer/Shader.h"
@@ -9,32 +19,14 @@
 #include <glm/glm.hpp>
 
 #include <map>
+#include <atomic>
 #include <queue>
 #include <thread>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 #include <condition_variable>
 
-struct ivec2_hash {
-    std::size_t operator()(const glm::ivec2& v) const noexcept {
-        // Convert to 64-bit to avoid overflow
-        uint64_t x = static_cast<uint32_t>(v.x);
-        uint64_t y = static_cast<uint32_t>(v.y);
-
-        uint64_t hash = x * 73856093ull ^y * 73856093ull;
-        return std::hash<uint64_t>()(hash);
-    }
-};
-
-struct ivec2_eq {
-    bool operator()(const glm::ivec2& a, const glm::ivec2& b) const noexcept {
-        return a.x == b.x && a.y == b.y;
-    }
-};
-
-using ChunkMap = std::unordered_map<glm::ivec2, std::shared_ptr<Chunk>, ivec2_hash>;
-using ChunkMapIterator = ChunkMap::const_iterator;
-
 struct Block {
     BlockType Type = BlockType::VOID;
     glm::ivec2 Chunk;
@@ -45,46 +37,186 @@ struct Block {
 enum ChunkJobType {
     GENERATE,
     DECORATE,
-    MESH
+    MESH,
+    REMESH, // rebuilds only the edited sections of a meshed chunk
+    SAVE, // writes queued chunk blocks to region files and queued edits to the journal
+    LOAD // submits the reads of the saved chunks of one dispatch as a single I/O batch, each completed read becomes a GENERATE job
 };
 
 struct ChunkJob {
     ChunkJobType Type;
     std::shared_ptr<Chunk> Chunk;
+
+    // blocks MESH and REMESH jobs read instead of the live chunks, taken on dispatch
+    std::shared_ptr<ChunkSnapshot> Snapshot;
+
+    // sections the REMESH job rebuilds, one bit per section
+    uint32_t Sections = 0;
+
+    // chunks the LOAD job reads, taken from the GENERATE jobs of the same dispatch
+    std::vector<std::shared_ptr<::Chunk>> Batch;
+
+    // saved blocks the GENERATE job decodes instead of generating, read by a LOAD job
+    std::shared_ptr<std::vector<uint8_t>> Data;
+
+    // lower runs sooner
+    float Priority = 0.0f;
 };
 
 class ChunkManager {
 public:
-    ChunkManager();
+    // radius is the largest chunk distance from the camera kept loaded, the seed only applies to a new world
+    ChunkManager(int radius, std::optional<uint32_t> seed = std::nullopt);
     ~ChunkManager();
 
+    // jobs are scheduled on the main thread and reach the workers through DispatchChunkJobs
     void AddChunkJob(const ChunkJob& job);
+    void AddChunkJobs(const std::vector<ChunkJob>& jobs);
+
+    void DispatchChunkJobs(const glm::vec3& cameraPosition, const Intersects::Frustum& frustum);
 
+    // chunks still in the cache are restored instead of created
     std::shared_ptr<Chunk> CreateChunk(glm::ivec2 position);
     void DestroyChunk(glm::ivec2 position);
 
+    // expires cached meshes, evicts cached chunks over the memory budget and collects the chunk pool
+    void UpdateChunkCache();
+
     bool ChunkExists(glm::ivec2 position);
 
-    std::shared_ptr<Chunk> GetChunk(glm::ivec2 position);
+    // true when the chunk and its 8 neighbors have finished decoration
+    bool NeighborsDecorated(glm::ivec2 position);
 
+    std::shared_ptr<ChunkSnapshot> CreateSnapshot(glm::ivec2 position, int firstSection = 0, int lastSection = Chunk::s_SectionCount - 1);
+
+    const std::shared_ptr<Chunk>& GetChunk(glm::ivec2 position);
+
+    // VOID outside loaded chunks and in chunks that are not decorated yet
     Block GetBlock(glm::vec3 position);
+
+    // edited sections are remeshed together on the next dispatch, not right away
     void CreateBlock(const Block& block);
 
-    ChunkMapIterator ChunksBegin();
-    ChunkMapIterator ChunksEnd();
+    const WorldGenerator& GetWorldGenerator() const;
+
+    const ChunkStore& GetChunks() const;
+    const ChunkPool& GetChunkPool() const;
+    const ChunkCache& GetChunkCache() const;
+
+    size_t GetMemoryUsage();
+
+    MeshingMode GetMeshingMode() const;
+    void SetMeshingMode(MeshingMode mode);
+
+    size_t GetWorkerCount() const;
+    // chunks whose mesh is ready to be loaded on GPU, main thread only
+    bool PopMeshedChunk(std::shared_ptr<Chunk>& chunk);
+
+    // buffers chunks are meshed into, reused so meshing does not allocate, main thread only
+    std::unique_ptr<ChunkMeshStaging> AcquireMeshStaging();
+    void ReleaseMeshStaging(std::unique_ptr<ChunkMeshStaging> staging);
+
+    // pages in the saved chunks around the camera before their jobs read them
+    void PrefetchChunks(glm::ivec2 center, int radius);
+
+    // name of the backend region files are read and written with
+    const char* GetIOBackendName() const;
+
+    // chunks read from region files and chunks generated from noise
+    size_t GetChunksLoaded() const;
+    size_t GetChunksGenerated() const;
+
+    size_t GetChunksMeshed() const;
+    size_t GetScheduledJobCount() const;
+    size_t GetChunkJobsCancelled() const;
 private:
-    void ChunkJobsWorker();
+    void ExecuteChunkJob(ChunkJob& job);
+
+    // heavily edited chunks are saved whole when they are removed, and loaded instead of generated
+    void SaveChunk(const std::shared_ptr<Chunk>& chunk);
+    void LoadChunks(const std::vector<std::shared_ptr<Chunk>>& chunks);
+
+    // applies the journaled edits on top of generated or loaded blocks
+    void ReplayEdits(Chunk& chunk);
+
+    // removed chunks go to the cache when they can be restored as they are, otherwise to the pool
+    void RetireChunk(std::shared_ptr<Chunk> chunk);
+
+    void MarkBlockDirty(const glm::vec3& position);
+    void ScheduleDirtyChunks();
+
+    float GetChunkJobPriority(const ChunkJob& job, const glm::vec3& cameraPosition, const Intersects::Frustum& frustum);
 private:
     std::shared_ptr<Renderer::TextureAtlas> m_TextureAtlas;
     std::shared_ptr<Renderer::Shader> m_ChunkShader;
 
-    ChunkMap m_Chunks;
-    std::mutex m_ChunksMutex;
+    // chunks are only touched by the main thread, workers get their chunk through the job
+    ChunkStore m_Chunks;
+
+    // removed chunks, recycled by CreateChunk instead of allocating new ones
+    ChunkPool m_ChunkPool;
+
+    // chunks that left the view distance recently, restored when the camera comes back
+    ChunkCache m_ChunkCache;
+
+    // region files of the heavily edited chunks, written by SAVE jobs and read by LOAD jobs
+    WorldStorage m_WorldStorage;
+
+    // every edit since a chunk was last saved whole, replayed by GENERATE and DECORATE jobs
+    EditJournal m_EditJournal;
+    std::atomic<bool> m_JournalFlushQueued = false;
+
+    // seeded noise shared read-only by the GENERATE and DECORATE jobs
+    std::unique_ptr<WorldGenerator> m_WorldGenerator;
+
+    std::atomic<MeshingMode> m_MeshingMode = MeshingMode::GREEDY;
 private:
-    bool m_ChunkJobsWorkerRunning = true;
-    
-    std::thread m_ChunkJobsWorker;
-    std::queue<ChunkJob> m_ChunkJobs;
-    std::mutex m_ChunkJobsMutex;
-    std::condition_variable m_ChunkJobsSignal;
+    std::unique_ptr<ChunkJobPool> m_ChunkJobPool;
+    std::atomic<size_t> m_ChunksMeshed = 0;
+    std::atomic<size_t> m_ChunksLoaded = 0;
+    std::atomic<size_t> m_ChunksGenerated = 0;
+    std::atomic<size_t> m_ChunkJobsCancelled = 0;
+
+    // workers push chunks once their mesh is built
+    MPSCQueue<std::shared_ptr<Chunk>> m_MeshedChunks;
+
+    // jobs waiting for a free worker, re-scored on every dispatch
+    std::vector<ChunkJob> m_ScheduledJobs;
+
+    // snapshots of MESH and REMESH jobs, returned by the worker once the mesh is built
+    ChunkSnapshotPool m_SnapshotPool;
+
+    // staging buffers returned after upload, ready for the next mesh job
+    std::vector<std::unique_ptr<ChunkMeshStaging>> m_MeshStagingPool;
+
+    // chunks with edited sections, each chunk is listed once however many blocks changed
+    std::vector<std::shared_ptr<Chunk>> m_DirtyChunks;
+
+    // seed of new worlds when none is selected, the one every world had before seeds were selectable
+    static const uint32_t s_DefaultSeed = 1234567890;
+
+    // jobs handed to the pool per worker, keeping it short lets new priorities apply quickly
+    static const size_t s_JobsPerWorker = 2;
+
+    // removed chunks kept for reuse, enough to cover the ring the camera leaves behind
+    static const size_t s_ChunkPoolCapacity = 128;
+
+    // cached chunks stop at this many bytes of blocks and meshes, meshes are dropped after the grace period
+    static const size_t s_ChunkCacheBudget = 64 * 1024 * 1024;
+    static constexpr float s_ChunkCacheMeshGracePeriod = 10.0f; // in seconds
+
+    // staging buffers kept for reuse, the rest are freed when a burst of uploads is over
+    static const size_t s_MaxPooledMeshStaging = 32;
+
+    // chunks outside of the camera frustum are scheduled as if they were this many times further away
+    static constexpr float s_OutOfFrustumPenalty = 4.0f;
+
+    // edits are right in front of the player, their remesh goes ahead of every other job
+    static constexpr float s_RemeshPriorityOffset = -1.0e6f;
+
+    // past this many edits a removed chunk is saved whole, a dump is a few KB and an edit 12 bytes
+    static const size_t s_MaxJournalEditsPerChunk = 256;
+
+    // saves are short and keep their data queued in memory, so they do not wait behind generation
+    static constexpr float s_SavePriorityOffset = -1.0e6f;
 };
@@ -0,0 +1,71 @@
+#include "ChunkPool.h"
+
+#include <atomic>
+
+ChunkPool::ChunkPool(size_t capacity) {
+    m_Capacity = capacity;
+
+    m_Released.reserve(capacity);
+    m_Free.reserve(capacity);
+}
+
+ChunkPool::~ChunkPool() {
+}
+
+std::shared_ptr<Chunk> ChunkPool::Acquire(glm::ivec2 key) {
+    if(m_Free.empty()) {
+        Collect();
+    }
+
+    if(m_Free.empty()) {
+        m_Misses++;
+        return nullptr;
+    }
+
+    std::shared_ptr<Chunk> chunk = std::move(m_Free.back());
+    m_Free.pop_back();
+
+    chunk->Recycle(key);
+
+    m_Hits++;
+    return chunk;
+}
+
+void ChunkPool::Release(std::shared_ptr<Chunk> chunk) {
+    // a worker may hold the last reference, dropping it there would delete GL objects without a context
+    m_Released.push_back(std::move(chunk));
+}
+
+void ChunkPool::Collect() {
+    // workers drop their references with a release decrement, this pairs with it
+    // so everything a worker wrote to the chunk is visible before it is reused
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    for(size_t i = 0; i < m_Released.size();) {
+        if(m_Released[i].use_count() == 1) {
+            // over capacity the chunk is destroyed here, on the main thread
+            if(m_Free.size() < m_Capacity) {
+                m_Free.push_back(std::move(m_Released[i]));
+            } else {
+                m_Released[i] = nullptr;
+            }
+
+            m_Released[i] = std::move(m_Released.back());
+            m_Released.pop_back();
+        } else {
+            i++;
+        }
+    }
+}
+
+size_t ChunkPool::GetCount() const {
+    return m_Released.size() + m_Free.size();
+}
+
+size_t ChunkPool::GetHits() const {
+    return m_Hits;
+}
+
+size_t ChunkPool::GetMisses() const {
+    return m_Misses;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Chunk.h"
+
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <vector>
+
+// Bounded pool of removed chunks. A released chunk may still be held by a job
+// or by the meshed queue, so it only becomes free once the pool holds its last
+// reference. Every released chunk is parked until then, even past capacity, so
+// the last reference always drops on the main thread, where the chunk can free
+// its GL objects. Acquire hands out a free chunk recycled to the new position,
+// or nothing when the pool is empty and the caller has to create a chunk. The
+// pool is not synchronized, it is used from the main thread only.
+class ChunkPool {
+public:
+    // capacity is the largest number of free chunks the pool keeps
+    ChunkPool(size_t capacity);
+    ~ChunkPool();
+
+    std::shared_ptr<Chunk> Acquire(glm::ivec2 key);
+    void Release(std::shared_ptr<Chunk> chunk);
+
+    // moves released chunks nobody else holds to the free list, frees the ones past capacity
+    void Collect();
+
+    size_t GetCount() const;
+    size_t GetHits() const;
+    size_t GetMisses() const;
+private:
+    size_t m_Capacity = 0;
+
+    std::vector<std::shared_ptr<Chunk>> m_Released;
+    std::vector<std::shared_ptr<Chunk>> m_Free;
+
+    size_t m_Hits = 0;
+    size_t m_Misses = 0;
+};
@@ -0,0 +1,110 @@
+#include "ChunkSnapshot.h"
+
+#include <algorithm>
+
+ChunkSnapshot::ChunkSnapshot() {
+    m_Blocks.resize(static_cast<size_t>(s_Size) * s_Height * s_Size, BlockType::VOID);
+}
+
+ChunkSnapshot::~ChunkSnapshot() {
+
+}
+
+void ChunkSnapshot::Capture(const std::array<std::shared_ptr<Chunk>, 9>& chunks, int firstSection, int lastSection) {
+    // meshing a section reads one block into the sections above and below
+    firstSection = std::max(firstSection - 1, 0);
+    lastSection = std::min(lastSection + 1, Chunk::s_SectionCount - 1);
+
+    for(int z = -1; z <= Chunk::s_ChunkSize; z++) {
+        for(int x = -1; x <= Chunk::s_ChunkSize; x++) {
+            // pick the chunk owning this column
+            int chunkX = x < 0 ? -1 : (x >= Chunk::s_ChunkSize ? 1 : 0);
+            int chunkZ = z < 0 ? -1 : (z >= Chunk::s_ChunkSize ? 1 : 0);
+
+            const std::shared_ptr<Chunk>& chunk = chunks[(chunkZ + 1) * 3 + (chunkX + 1)];
+
+            CaptureColumn(x, z, chunk, x - chunkX * Chunk::s_ChunkSize, z - chunkZ * Chunk::s_ChunkSize, firstSection, lastSection);
+        }
+    }
+
+    CaptureSectionVisibility(chunks);
+}
+
+bool ChunkSnapshot::SectionHidden(int section) const {
+    return m_SectionHidden[section];
+}
+
+void ChunkSnapshot::CaptureColumn(int x, int z, const std::shared_ptr<Chunk>& chunk, int localX, int localZ, int firstSection, int lastSection) {
+    // below and above the world is always void
+    m_Blocks[(static_cast<size_t>(0) * s_Size + (z + 1)) * s_Size + (x + 1)] = BlockType::VOID;
+    m_Blocks[(static_cast<size_t>(s_Height - 1) * s_Size + (z + 1)) * s_Size + (x + 1)] = BlockType::VOID;
+
+    for(int section = firstSection; section <= lastSection; section++) {
+        int sectionY = section * Chunk::s_ChunkSize;
+
+        if(!chunk) {
+            for(int y = 0; y < Chunk::s_ChunkSize; y++) {
+                m_Blocks[(static_cast<size_t>(sectionY + y + 1) * s_Size + (z + 1)) * s_Size + (x + 1)] = BlockType::VOID;
+            }
+
+            continue;
+        }
+
+        const BlockStorage& storage = chunk->GetSection(section);
+
+        for(int y = 0; y < Chunk::s_ChunkSize; y++) {
+            BlockType type = storage.IsUniform() ? storage.Get(0) : storage.Get(Chunk::GetBlockIndex(localX, y, localZ));
+            m_Blocks[(static_cast<size_t>(sectionY + y + 1) * s_Size + (z + 1)) * s_Size + (x + 1)] = type;
+        }
+    }
+}
+
+void ChunkSnapshot::CaptureSectionVisibility(const std::array<std::shared_ptr<Chunk>, 9>& chunks) {
+    const std::shared_ptr<Chunk>& center = chunks[4];
+
+    // front, back, left, right
+    const std::shared_ptr<Chunk>* chunkNeighbors[4] = {
+        &chunks[7],
+        &chunks[1],
+        &chunks[3],
+        &chunks[5]
+    };
+
+    for(int section = 0; section < Chunk::s_SectionCount; section++) {
+        m_SectionHidden[section] = false;
+
+        BlockType type;
+
+        if(!center->GetSectionType(section, type)) {
+            continue;
+        }
+
+        if(type == BlockType::AIR) {
+            m_SectionHidden[section] = true;
+            continue;
+        }
+
+        // uniform section is hidden only if none of its faces can be seen through a neighbor section
+        BlockType neighbors[6] = { BlockType::VOID, BlockType::VOID, BlockType::VOID, BlockType::VOID, BlockType::VOID, BlockType::VOID };
+        bool uniform = true;
+
+        for(size_t i = 0; i < 4; i++) {
+            const std::shared_ptr<Chunk>& chunk = *chunkNeighbors[i];
+
+            if(chunk && !chunk->GetSectionType(section, neighbors[i])) {
+                uniform = false;
+            }
+        }
+
+        if(!center->GetSectionType(section + 1, neighbors[4]) || !center->GetSectionType(section - 1, neighbors[5])) {
+            uniform = false;
+        }
+
+        if(!uniform) {
+            continue;
+        }
+
+        m_SectionHidden[section] = std::none_of(std::begin(neighbors), std::end(neighbors),
+                                                [type](BlockType neighbor) { return Chunk::FaceVisible(type, neighbor); });
+    }
+}
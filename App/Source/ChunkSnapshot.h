@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Chunk.h"
+
+#include <array>
+#include <vector>
+#include <memory>
+
+// Copy of a chunk's blocks padded with a one-block border taken from its
+// 8 horizontal neighbors (18x258x18). Meshing reads only the snapshot, so it
+// takes no locks, does no chunk lookups and never reads chunks while the
+// main thread mutates them.
+class ChunkSnapshot {
+public:
+    static const int s_Size = Chunk::s_ChunkSize + 2;
+    static const int s_Height = Chunk::s_ChunkHeight + 2;
+
+    ChunkSnapshot();
+    ~ChunkSnapshot();
+
+    // chunks are the 3x3 neighborhood indexed by (z + 1) * 3 + (x + 1), the captured chunk is in the middle,
+    // only blocks needed to mesh sections first to last are captured, the rest keeps what the last capture left
+    void Capture(const std::array<std::shared_ptr<Chunk>, 9>& chunks, int firstSection = 0, int lastSection = Chunk::s_SectionCount - 1);
+
+    // chunk-local coordinates, -1 and s_ChunkSize/s_ChunkHeight address the border
+    inline BlockType Get(int x, int y, int z) const {
+        return m_Blocks[(static_cast<size_t>(y + 1) * s_Size + (z + 1)) * s_Size + (x + 1)];
+    }
+
+    inline BlockType Get(const glm::vec3& position) const {
+        glm::ivec3 pos = glm::ivec3(glm::floor(position));
+        return Get(pos.x, pos.y, pos.z);
+    }
+
+    bool SectionHidden(int section) const;
+private:
+    void CaptureColumn(int x, int z, const std::shared_ptr<Chunk>& chunk, int localX, int localZ, int firstSection, int lastSection);
+    void CaptureSectionVisibility(const std::array<std::shared_ptr<Chunk>, 9>& chunks);
+private:
+    std::vector<BlockType> m_Blocks;
+    std::array<bool, Chunk::s_SectionCount> m_SectionHidden = { false };
+};
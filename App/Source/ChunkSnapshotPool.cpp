@@ -0,0 +1,43 @@
+#include "ChunkSnapshotPool.h"
+
+ChunkSnapshotPool::ChunkSnapshotPool(size_t capacity) {
+    m_Capacity = capacity;
+
+    m_Free.reserve(capacity);
+}
+
+ChunkSnapshotPool::~ChunkSnapshotPool() {
+}
+
+std::shared_ptr<ChunkSnapshot> ChunkSnapshotPool::Acquire() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        if(!m_Free.empty()) {
+            std::shared_ptr<ChunkSnapshot> snapshot = std::move(m_Free.back());
+            m_Free.pop_back();
+
+            return snapshot;
+        }
+    }
+
+    return std::make_shared<ChunkSnapshot>();
+}
+
+void ChunkSnapshotPool::Release(std::shared_ptr<ChunkSnapshot> snapshot) {
+    // a snapshot another job still reads cannot be captured into again
+    if(!snapshot || snapshot.use_count() != 1) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if(m_Free.size() < m_Capacity) {
+        m_Free.push_back(std::move(snapshot));
+    }
+}
+
+size_t ChunkSnapshotPool::GetCount() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Free.size();
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "ChunkSnapshot.h"
+
+#include <mutex>
+#include <memory>
+#include <vector>
+
+// Bounded pool of chunk snapshots. The main thread acquires one for every
+// MESH and REMESH job it dispatches, and the worker releases it once the mesh
+// is built, so snapshots are reused rather than allocated per job. Released
+// snapshots past the capacity, and snapshots still held elsewhere, are freed
+// instead. Acquire and Release may be called from any thread.
+class ChunkSnapshotPool {
+public:
+    // capacity is the largest number of free snapshots the pool keeps
+    ChunkSnapshotPool(size_t capacity);
+    ~ChunkSnapshotPool();
+
+    // a reused snapshot still holds the blocks of its last capture
+    std::shared_ptr<ChunkSnapshot> Acquire();
+    void Release(std::shared_ptr<ChunkSnapshot> snapshot);
+
+    size_t GetCount() const;
+private:
+    size_t m_Capacity = 0;
+
+    std::vector<std::shared_ptr<ChunkSnapshot>> m_Free;
+    mutable std::mutex m_Mutex;
+};
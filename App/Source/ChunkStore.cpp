@@ -0,0 +1,74 @@
+#include "ChunkStore.h"
+
+const std::shared_ptr<Chunk> ChunkStore::s_Empty = nullptr;
+
+ChunkStore::ChunkStore(int radius) {
+    // smallest power of two that fits the whole diameter
+    m_Size = 1;
+
+    while(m_Size < radius * 2 + 1) {
+        m_Size *= 2;
+    }
+
+    m_Mask = m_Size - 1;
+
+    m_Slots.resize(static_cast<size_t>(m_Size) * m_Size);
+    m_Chunks.reserve(m_Slots.size());
+}
+
+ChunkStore::~ChunkStore() {
+}
+
+std::shared_ptr<Chunk> ChunkStore::Insert(const std::shared_ptr<Chunk>& chunk) {
+    glm::ivec2 position = chunk->GetKey();
+
+    std::shared_ptr<Chunk> evicted = nullptr;
+    Slot& slot = m_Slots[GetSlotIndex(position)];
+
+    if(slot.Chunk) {
+        evicted = Remove(slot.Position);
+    }
+
+    slot.Position = position;
+    slot.Chunk = chunk;
+    slot.Index = m_Chunks.size();
+
+    m_Chunks.push_back(chunk);
+
+    return evicted;
+}
+
+std::shared_ptr<Chunk> ChunkStore::Remove(glm::ivec2 position) {
+    Slot& slot = m_Slots[GetSlotIndex(position)];
+
+    if(!slot.Chunk || slot.Position != position) {
+        return nullptr;
+    }
+
+    std::shared_ptr<Chunk> chunk = std::move(slot.Chunk);
+    slot.Chunk = nullptr;
+
+    // swap with the last chunk to keep the list dense
+    size_t index = slot.Index;
+
+    if(index != m_Chunks.size() - 1) {
+        m_Chunks[index] = std::move(m_Chunks.back());
+        m_Slots[GetSlotIndex(m_Chunks[index]->GetKey())].Index = index;
+    }
+
+    m_Chunks.pop_back();
+
+    return chunk;
+}
+
+size_t ChunkStore::GetCount() const {
+    return m_Chunks.size();
+}
+
+ChunkStore::Iterator ChunkStore::begin() const {
+    return m_Chunks.begin();
+}
+
+ChunkStore::Iterator ChunkStore::end() const {
+    return m_Chunks.end();
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Chunk.h"
+
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <vector>
+
+// Chunks around the camera in a fixed 2D ring buffer. Slots are addressed by
+// chunk coordinates modulo the grid size, so as long as all chunks fit in a
+// square of that size the camera can move without anything being copied, and
+// lookups are a mask and a compare. Chunks are also kept in a dense list for
+// iteration. The store is not synchronized, it is used from the main thread only.
+class ChunkStore {
+public:
+    using Iterator = std::vector<std::shared_ptr<Chunk>>::const_iterator;
+
+    // radius is the largest chunk distance from the center the store has to hold
+    ChunkStore(int radius);
+    ~ChunkStore();
+
+    // returns the chunk evicted from the slot, if a chunk out of range was still there
+    std::shared_ptr<Chunk> Insert(const std::shared_ptr<Chunk>& chunk);
+    std::shared_ptr<Chunk> Remove(glm::ivec2 position);
+
+    inline const std::shared_ptr<Chunk>& Get(glm::ivec2 position) const {
+        const Slot& slot = m_Slots[GetSlotIndex(position)];
+
+        if(slot.Chunk && slot.Position == position) {
+            return slot.Chunk;
+        }
+
+        return s_Empty;
+    }
+
+    inline bool Contains(glm::ivec2 position) const {
+        return Get(position) != nullptr;
+    }
+
+    size_t GetCount() const;
+
+    Iterator begin() const;
+    Iterator end() const;
+private:
+    struct Slot {
+        glm::ivec2 Position = glm::ivec2(0);
+        std::shared_ptr<Chunk> Chunk;
+
+        // position in the dense list
+        size_t Index = 0;
+    };
+
+    inline size_t GetSlotIndex(glm::ivec2 position) const {
+        // grid size is a power of two, masking wraps negative coordinates too
+        return static_cast<size_t>(position.y & m_Mask) * m_Size + static_cast<size_t>(position.x & m_Mask);
+    }
+private:
+    int m_Size = 0;
+    int m_Mask = 0;
+
+    std::vector<Slot> m_Slots;
+    std::vector<std::shared_ptr<Chunk>> m_Chunks;
+
+    static const std::shared_ptr<Chunk> s_Empty;
+};
@@ -0,0 +1,282 @@
+#include "EditJournal.h"
+#include "BlockRegistry.h"
+#include "MappedFile.h"
+
+#include <string.h>
+#include <iostream>
+#include <algorithm>
+
+EditJournal::EditJournal(const std::filesystem::path& path) {
+    m_Path = path;
+
+    // replay the file into memory straight from its mapping, a record cut short by a crash is ignored
+    MappedFile file;
+    file.Open(m_Path);
+
+    size_t recordCount = file.GetData() ? file.GetSize() / s_RecordSize : 0;
+
+    for(size_t i = 0; i < recordCount; i++) {
+        const uint8_t* record = file.GetData() + i * s_RecordSize;
+        int32_t x, z;
+        uint16_t index;
+
+        memcpy(&x, record, 4);
+        memcpy(&z, record + 4, 4);
+        memcpy(&index, record + 8, 2);
+
+        if(record[10] >= std::size(BlockRegistry::s_Blocks) || record[11] >= std::size(BlockRegistry::s_Blocks)) {
+            continue;
+        }
+
+        m_RecordCount++;
+
+        if(record[10] == BlockType::VOID && record[11] == BlockType::VOID) {
+            DropEdits({ x, z });
+            continue;
+        }
+
+        ApplyEdit({ x, z }, { index, static_cast<BlockType>(record[10]), static_cast<BlockType>(record[11]) });
+    }
+
+    file.Close();
+
+    m_File.open(m_Path, std::ios::binary | std::ios::app);
+
+    if(!m_File.is_open()) {
+        std::cerr << "Failed to open edit journal: " << m_Path.string() << std::endl;
+    }
+}
+
+EditJournal::~EditJournal() {
+    Flush();
+}
+
+void EditJournal::Append(glm::ivec2 chunk, const BlockEdit& edit) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    ApplyEdit(chunk, edit);
+
+    WriteRecord(m_Pending, chunk, edit);
+    m_PendingCount++;
+}
+
+void EditJournal::GetEdits(glm::ivec2 chunk, std::vector<BlockEdit>& edits) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    edits.clear();
+
+    if(auto it = m_Edits.find(GetKey(chunk)); it != m_Edits.end()) {
+        edits = it->second;
+    }
+}
+
+size_t EditJournal::GetEditCount(glm::ivec2 chunk) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    auto it = m_Edits.find(GetKey(chunk));
+    return it != m_Edits.end() ? it->second.size() : 0;
+}
+
+void EditJournal::Drop(glm::ivec2 chunk) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    DropEdits(chunk);
+
+    // the file is replayed on start, it has to forget the older records too
+    WriteRecord(m_Pending, chunk, { 0, BlockType::VOID, BlockType::VOID });
+    m_PendingCount++;
+}
+
+void EditJournal::Flush(const std::function<bool()>& saveChunks) {
+    std::lock_guard<std::mutex> fileLock(m_FileMutex);
+
+    std::vector<uint8_t> pending;
+    size_t pendingCount = 0;
+    size_t editCount = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        pending.swap(m_Pending);
+        pendingCount = m_PendingCount;
+        editCount = m_EditCount;
+
+        m_PendingCount = 0;
+    }
+
+    // every drop taken above was queued after its blocks, so they are written by now,
+    // without the drop the chunk's older edits are replayed again, which gives the same blocks
+    bool saved = !saveChunks || saveChunks();
+
+    if(!saved) {
+        pendingCount -= RemoveDropRecords(pending);
+    }
+
+    if(!pending.empty() && m_File.is_open()) {
+        m_File.write(reinterpret_cast<const char*>(pending.data()), pending.size());
+        m_File.flush();
+
+        m_RecordCount += pendingCount;
+    }
+
+    // the rewritten file has no edits of dropped chunks, it waits until their blocks are written
+    if(saved && m_RecordCount >= s_CompactMinRecords && m_RecordCount > editCount * s_CompactStaleRatio) {
+        Compact(saveChunks);
+    }
+}
+
+size_t EditJournal::GetEditCount() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_EditCount;
+}
+
+uint16_t EditJournal::GetEditIndex(const glm::ivec3& position) {
+    return static_cast<uint16_t>((position.y << 8) | (position.z << 4) | position.x);
+}
+
+glm::ivec3 EditJournal::GetEditPosition(uint16_t index) {
+    return { index & 15, index >> 8, (index >> 4) & 15 };
+}
+
+void EditJournal::ApplyEdit(glm::ivec2 chunk, const BlockEdit& edit) {
+    std::vector<BlockEdit>& edits = m_Edits[GetKey(chunk)];
+
+    auto it = std::find_if(edits.begin(), edits.end(), [&edit](const BlockEdit& e) { return e.Index == edit.Index; });
+
+    if(it == edits.end()) {
+        edits.push_back(edit);
+        m_EditCount++;
+        return;
+    }
+
+    // the block keeps the type it was generated with, only the latest one matters
+    it->New = edit.New;
+
+    if(it->New == it->Old) {
+        edits.erase(it);
+        m_EditCount--;
+    }
+
+    if(edits.empty()) {
+        m_Edits.erase(GetKey(chunk));
+    }
+}
+
+void EditJournal::DropEdits(glm::ivec2 chunk) {
+    if(auto it = m_Edits.find(GetKey(chunk)); it != m_Edits.end()) {
+        m_EditCount -= it->second.size();
+        m_Edits.erase(it);
+    }
+}
+
+void EditJournal::WriteRecord(std::vector<uint8_t>& data, glm::ivec2 chunk, const BlockEdit& edit) {
+    uint8_t record[s_RecordSize];
+
+    int32_t x = chunk.x;
+    int32_t z = chunk.y;
+
+    memcpy(record, &x, 4);
+    memcpy(record + 4, &z, 4);
+    memcpy(record + 8, &edit.Index, 2);
+
+    record[10] = edit.Old;
+    record[11] = edit.New;
+
+    data.insert(data.end(), record, record + s_RecordSize);
+}
+
+size_t EditJournal::RemoveDropRecords(std::vector<uint8_t>& data) {
+    size_t size = 0;
+
+    for(size_t offset = 0; offset + s_RecordSize <= data.size(); offset += s_RecordSize) {
+        const uint8_t* record = data.data() + offset;
+
+        if(record[10] == BlockType::VOID && record[11] == BlockType::VOID) {
+            continue;
+        }
+
+        memmove(data.data() + size, record, s_RecordSize);
+        size += s_RecordSize;
+    }
+
+    size_t removed = (data.size() - size) / s_RecordSize;
+    data.resize(size);
+
+    return removed;
+}
+
+void EditJournal::Compact(const std::function<bool()>& saveChunks) {
+    std::vector<uint8_t> data;
+    size_t recordCount = 0;
+
+    {
+        // appends keep going while the file is rewritten, they are queued for the next flush
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        data.reserve(m_EditCount * s_RecordSize);
+
+        for(const auto& [key, edits] : m_Edits) {
+            for(const auto& edit : edits) {
+                WriteRecord(data, GetPosition(key), edit);
+            }
+        }
+
+        recordCount = m_EditCount;
+
+        // queued records are merged into memory already, the rewritten file has them too
+        m_Pending.clear();
+        m_PendingCount = 0;
+    }
+
+    // on failure the merged records are queued again, ahead of the ones appended since
+    auto requeue = [this, &data, recordCount]() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        m_Pending.insert(m_Pending.begin(), data.begin(), data.end());
+        m_PendingCount += recordCount;
+    };
+
+    // chunks dropped since the last flush are missing from the rewritten file, their blocks have to be on disk first
+    if(saveChunks && !saveChunks()) {
+        requeue();
+        return;
+    }
+
+    // the old file stays valid until the new one replaces it
+    std::filesystem::path path = m_Path;
+    path += ".tmp";
+
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+
+        if(!file) {
+            std::cerr << "Failed to compact edit journal: " << path.string() << std::endl;
+
+            requeue();
+            return;
+        }
+    }
+
+    m_File.close();
+
+    std::error_code error;
+    std::filesystem::rename(path, m_Path, error);
+
+    if(error) {
+        std::cerr << "Failed to replace edit journal: " << m_Path.string() << std::endl;
+        requeue();
+    } else {
+        m_RecordCount = recordCount;
+    }
+
+    m_File.open(m_Path, std::ios::binary | std::ios::app);
+}
+
+uint64_t EditJournal::GetKey(glm::ivec2 position) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(position.x)) << 32) | static_cast<uint32_t>(position.y);
+}
+
+glm::ivec2 EditJournal::GetPosition(uint64_t key) {
+    return { static_cast<int32_t>(key >> 32), static_cast<int32_t>(key & 0xFFFFFFFF) };
+}
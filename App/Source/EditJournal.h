@@ -0,0 +1,91 @@
+#pragma once
+
+#include "BlockType.h"
+
+#include <glm/glm.hpp>
+
+#include <mutex>
+#include <vector>
+#include <fstream>
+#include <functional>
+#include <stdint.h>
+#include <filesystem>
+#include <unordered_map>
+
+// A block changed by the player, relative to what the generator produced.
+struct BlockEdit {
+    uint16_t Index = 0; // y * 256 + z * 16 + x inside the chunk
+    BlockType Old = BlockType::AIR;
+    BlockType New = BlockType::AIR;
+};
+
+// Append-only file of the blocks the player changed. Terrain is generated
+// from a fixed seed, so a chunk is rebuilt by generating it and replaying its
+// edits on top. Edits are kept in memory per chunk, with repeated edits of a
+// block merged and edits back to the generated type dropped. Appending only
+// queues the record, Flush writes it, and rewrites the file from memory
+// (compaction) once most of its records are stale. Every method can be
+// called from any thread.
+class EditJournal {
+public:
+    EditJournal(const std::filesystem::path& path);
+    ~EditJournal();
+
+    void Append(glm::ivec2 chunk, const BlockEdit& edit);
+
+    // edits of the chunk in the order they have to be replayed
+    void GetEdits(glm::ivec2 chunk, std::vector<BlockEdit>& edits);
+    size_t GetEditCount(glm::ivec2 chunk);
+
+    // forgets the chunk's edits once its blocks are saved whole, edits made
+    // after that are replayed on top of the saved blocks
+    void Drop(glm::ivec2 chunk);
+
+    // writes the queued records, compacts the file when it is mostly stale;
+    // saveChunks writes the saved blocks the queued drops stand for, it runs
+    // once the records are taken and before any is written, and when it
+    // fails the drop records are left out, so the older edits are replayed
+    void Flush(const std::function<bool()>& saveChunks = nullptr);
+
+    size_t GetEditCount();
+
+    static uint16_t GetEditIndex(const glm::ivec3& position);
+    static glm::ivec3 GetEditPosition(uint16_t index);
+private:
+    // merges an edit into the chunk's list, mutex has to be held
+    void ApplyEdit(glm::ivec2 chunk, const BlockEdit& edit);
+    void DropEdits(glm::ivec2 chunk);
+
+    void WriteRecord(std::vector<uint8_t>& data, glm::ivec2 chunk, const BlockEdit& edit);
+    // removes the drop records from the data, returns how many there were
+    static size_t RemoveDropRecords(std::vector<uint8_t>& data);
+    void Compact(const std::function<bool()>& saveChunks);
+
+    static uint64_t GetKey(glm::ivec2 position);
+    static glm::ivec2 GetPosition(uint64_t key);
+private:
+    std::filesystem::path m_Path;
+
+    // held while the file is written, never by Append
+    std::mutex m_FileMutex;
+    std::ofstream m_File;
+
+    // records in the file, stale ones included
+    size_t m_RecordCount = 0;
+
+    // guards the edits and the queued records
+    std::mutex m_Mutex;
+    std::unordered_map<uint64_t, std::vector<BlockEdit>> m_Edits;
+    size_t m_EditCount = 0;
+
+    std::vector<uint8_t> m_Pending;
+    size_t m_PendingCount = 0;
+
+    // chunk x, chunk z, block index, old type, new type,
+    // a record with both types VOID drops the chunk's earlier edits
+    static const size_t s_RecordSize = 12;
+
+    // compaction waits for this many records, and for most of them to be stale
+    static const size_t s_CompactMinRecords = 4096;
+    static const size_t s_CompactStaleRatio = 2;
+};
@@ -39,6 +39,12 @@ void HUDLayer::OnEvent(Core::Event& event) {
     dispatcher.Dispatch<Core::PositionUpdatedEvent>([this](Core::PositionUpdatedEvent& e) { return OnPositionUpdatedEvent(e); });
     dispatcher.Dispatch<Core::TimeUpdatedEvent>([this](Core::TimeUpdatedEvent& e) { return OnTimeUpdatedEvent(e); });
     dispatcher.Dispatch<Core::ChunksGeneratedEvent>([this](Core::ChunksGeneratedEvent& e) { return OnChunksGeneratedEvent(e); });
+    dispatcher.Dispatch<Core::ChunksMemoryUpdatedEvent>([this](Core::ChunksMemoryUpdatedEvent& e) { return OnChunksMemoryUpdatedEvent(e); });
+    dispatcher.Dispatch<Core::ChunkPoolUpdatedEvent>([this](Core::ChunkPoolUpdatedEvent& e) { return OnChunkPoolUpdatedEvent(e); });
+    dispatcher.Dispatch<Core::ChunkCacheUpdatedEvent>([this](Core::ChunkCacheUpdatedEvent& e) { return OnChunkCacheUpdatedEvent(e); });
+    dispatcher.Dispatch<Core::WorldLoadedEvent>([this](Core::WorldLoadedEvent& e) { return OnWorldLoadedEvent(e); });
+    dispatcher.Dispatch<Core::ChunkJobsUpdatedEvent>([this](Core::ChunkJobsUpdatedEvent& e) { return OnChunkJobsUpdatedEvent(e); });
+    dispatcher.Dispatch<Core::ChunkUploadsUpdatedEvent>([this](Core::ChunkUploadsUpdatedEvent& e) { return OnChunkUploadsUpdatedEvent(e); });
     dispatcher.Dispatch<Core::MouseScrollEvent>([this](Core::MouseScrollEvent& e) { return OnMouseScrollEvent(e); });
 }
 
@@ -88,6 +94,30 @@ void HUDLayer::RenderDebugInfo() {
 
     // Chunks
     RenderDebugInfoLine(std::format("Created {} chunks in {} seconds.", m_DebugInfo.ChunksCreated, m_DebugInfo.ChunksCreatedTime));
+
+    // Chunks memory
+    float chunksMemory = m_DebugInfo.ChunksMemory / (1024.0f * 1024.0f);
+    float chunkMemory = m_DebugInfo.ChunksLoaded > 0 ? m_DebugInfo.ChunksMemory / 1024.0f / m_DebugInfo.ChunksLoaded : 0.0f;
+
+    RenderDebugInfoLine(std::format("Block data: {:.2f} MB ({:.2f} KB per chunk)", chunksMemory, chunkMemory));
+
+    // Chunk pool
+    RenderDebugInfoLine(std::format("Pool: {} chunks, {} hits, {} misses", m_DebugInfo.ChunksPooled, m_DebugInfo.ChunkPoolHits, m_DebugInfo.ChunkPoolMisses));
+
+    // Chunk cache
+    RenderDebugInfoLine(std::format("Cache: {} chunks, {:.2f} MB, {} hits, {} misses", m_DebugInfo.ChunksCached, m_DebugInfo.ChunkCacheBytes / (1024.0f * 1024.0f),
+                                    m_DebugInfo.ChunkCacheHits, m_DebugInfo.ChunkCacheMisses));
+
+    // Startup
+    RenderDebugInfoLine(std::format("World loaded in {:.2f} s ({} chunks read with {}, {} generated)", m_DebugInfo.WorldLoadTime, m_DebugInfo.WorldChunksLoaded, m_DebugInfo.WorldIOBackend, m_DebugInfo.WorldChunksGenerated));
+
+    // Chunk jobs
+    RenderDebugInfoLine(std::format("Meshing {:.1f} chunks/s on {} workers", m_DebugInfo.ChunksMeshedPerSecond, m_DebugInfo.Workers));
+    RenderDebugInfoLine(std::format("Jobs: {} scheduled, {} cancelled", m_DebugInfo.JobsScheduled, m_DebugInfo.JobsCancelled));
+
+    // Chunk uploads
+    RenderDebugInfoLine(std::format("Uploads: {} chunks, {:.1f} KB in {:.2f} ms, {} deferred", m_DebugInfo.ChunksUploaded, m_DebugInfo.ChunksUploadBytes / 1024.0f,
+                                    m_DebugInfo.ChunksUploadTime * 1000.0f, m_DebugInfo.ChunksUploadDeferred));
 }
 
 void HUDLayer::RenderDebugInfoLine(std::string line) {
@@ -115,6 +145,57 @@ bool HUDLayer::OnChunksGeneratedEvent(const Core::ChunksGeneratedEvent& event) {
     return false;
 }
 
+bool HUDLayer::OnChunksMemoryUpdatedEvent(const Core::ChunksMemoryUpdatedEvent& event) {
+    m_DebugInfo.ChunksLoaded = event.GetChunks();
+    m_DebugInfo.ChunksMemory = event.GetBytes();
+
+    return false;
+}
+
+bool HUDLayer::OnChunkPoolUpdatedEvent(const Core::ChunkPoolUpdatedEvent& event) {
+    m_DebugInfo.ChunksPooled = event.GetPooled();
+    m_DebugInfo.ChunkPoolHits = event.GetHits();
+    m_DebugInfo.ChunkPoolMisses = event.GetMisses();
+
+    return false;
+}
+
+bool HUDLayer::OnChunkCacheUpdatedEvent(const Core::ChunkCacheUpdatedEvent& event) {
+    m_DebugInfo.ChunksCached = event.GetCached();
+    m_DebugInfo.ChunkCacheBytes = event.GetBytes();
+    m_DebugInfo.ChunkCacheHits = event.GetHits();
+    m_DebugInfo.ChunkCacheMisses = event.GetMisses();
+
+    return false;
+}
+
+bool HUDLayer::OnWorldLoadedEvent(const Core::WorldLoadedEvent& event) {
+    m_DebugInfo.WorldLoadTime = event.GetTime();
+    m_DebugInfo.WorldChunksLoaded = event.GetChunksLoaded();
+    m_DebugInfo.WorldChunksGenerated = event.GetChunksGenerated();
+    m_DebugInfo.WorldIOBackend = event.GetIOBackend();
+
+    return false;
+}
+
+bool HUDLayer::OnChunkJobsUpdatedEvent(const Core::ChunkJobsUpdatedEvent& event) {
+    m_DebugInfo.Workers = event.GetWorkers();
+    m_DebugInfo.ChunksMeshedPerSecond = event.GetChunksMeshedPerSecond();
+    m_DebugInfo.JobsScheduled = event.GetJobsScheduled();
+    m_DebugInfo.JobsCancelled = event.GetJobsCancelled();
+
+    return false;
+}
+
+bool HUDLayer::OnChunkUploadsUpdatedEvent(const Core::ChunkUploadsUpdatedEvent& event) {
+    m_DebugInfo.ChunksUploaded = event.GetUploaded();
+    m_DebugInfo.ChunksUploadDeferred = event.GetDeferred();
+    m_DebugInfo.ChunksUploadBytes = event.GetBytes();
+    m_DebugInfo.ChunksUploadTime = event.GetTime();
+
+    return false;
+}
+
 bool HUDLayer::OnMouseScrollEvent(const Core::MouseScrollEvent& event) {
     m_Inventory.SetSelectedItem(event.GetYOffset());
     
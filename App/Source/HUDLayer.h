@@ -10,6 +10,7 @@
 
 #include <glm/glm.hpp>
 
+#include <string>
 #include <stdint.h>
 
 struct DebugInfo {
@@ -25,6 +26,39 @@ struct DebugInfo {
     // ChunksGenerated
     int ChunksCreated = 0;
     float ChunksCreatedTime = 0.0f;
+
+    // ChunksMemoryUpdated
+    int ChunksLoaded = 0;
+    size_t ChunksMemory = 0;
+
+    // ChunkPoolUpdated
+    int ChunksPooled = 0;
+    size_t ChunkPoolHits = 0;
+    size_t ChunkPoolMisses = 0;
+
+    // ChunkCacheUpdated
+    int ChunksCached = 0;
+    size_t ChunkCacheBytes = 0;
+    size_t ChunkCacheHits = 0;
+    size_t ChunkCacheMisses = 0;
+
+    // WorldLoaded
+    float WorldLoadTime = 0.0f;
+    int WorldChunksLoaded = 0;
+    int WorldChunksGenerated = 0;
+    std::string WorldIOBackend;
+
+    // ChunkJobsUpdated
+    int Workers = 0;
+    float ChunksMeshedPerSecond = 0.0f;
+    int JobsScheduled = 0;
+    int JobsCancelled = 0;
+
+    // ChunkUploadsUpdated
+    int ChunksUploaded = 0;
+    int ChunksUploadDeferred = 0;
+    size_t ChunksUploadBytes = 0;
+    float ChunksUploadTime = 0.0f;
 };
 
 class HUDLayer : public Core::Layer {
@@ -43,6 +77,12 @@ private:
     bool OnPositionUpdatedEvent(const Core::PositionUpdatedEvent& event);
     bool OnTimeUpdatedEvent(const Core::TimeUpdatedEvent& event);
     bool OnChunksGeneratedEvent(const Core::ChunksGeneratedEvent& event);
+    bool OnChunksMemoryUpdatedEvent(const Core::ChunksMemoryUpdatedEvent& event);
+    bool OnChunkPoolUpdatedEvent(const Core::ChunkPoolUpdatedEvent& event);
+    bool OnChunkCacheUpdatedEvent(const Core::ChunkCacheUpdatedEvent& event);
+    bool OnWorldLoadedEvent(const Core::WorldLoadedEvent& event);
+    bool OnChunkJobsUpdatedEvent(const Core::ChunkJobsUpdatedEvent& event);
+    bool OnChunkUploadsUpdatedEvent(const Core::ChunkUploadsUpdatedEvent& event);
     bool OnMouseScrollEvent(const Core::MouseScrollEvent& event);
 private:
     Renderer::Quad m_Crosshair;
@@ -0,0 +1,415 @@
+#include "IOBackend.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#ifdef CRAFTMINE_LIBURING
+    #include <liburing.h>
+    #include <string.h>
+#endif
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <iostream>
+#include <algorithm>
+#include <unordered_set>
+#include <condition_variable>
+
+// regular files only come up short at the end of the file, but signals can interrupt a transfer
+static int64_t Transfer(const IORequest& request) {
+    size_t done = 0;
+
+    while(done < request.Size) {
+        uint64_t offset = request.Offset + done;
+        size_t size = request.Size - done;
+
+#ifdef _WIN32
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        HANDLE file = reinterpret_cast<HANDLE>(request.File);
+        DWORD chunk = static_cast<DWORD>(std::min<size_t>(size, 1u << 30));
+        DWORD transferred = 0;
+
+        BOOL success = request.Type == IOType::READ ? ReadFile(file, request.Buffer + done, chunk, &transferred, &overlapped)
+                                                    : WriteFile(file, request.Buffer + done, chunk, &transferred, &overlapped);
+
+        if(!success) {
+            return GetLastError() == ERROR_HANDLE_EOF ? static_cast<int64_t>(done) : -1;
+        }
+
+        int64_t result = transferred;
+#else
+        int file = static_cast<int>(request.File);
+
+        ssize_t result = request.Type == IOType::READ ? pread(file, request.Buffer + done, size, static_cast<off_t>(offset))
+                                                      : pwrite(file, request.Buffer + done, size, static_cast<off_t>(offset));
+
+        if(result < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if(result < 0) {
+            return -errno;
+        }
+#endif
+
+        if(result == 0) {
+            break;
+        }
+
+        done += static_cast<size_t>(result);
+    }
+
+    return static_cast<int64_t>(done);
+}
+
+// runs the requests one by one on the calling thread
+class PositionalIOBackend : public IOBackend {
+public:
+    void Submit(const std::vector<IORequest>& requests, const IOCompletion& completion) override {
+        for(const auto& request : requests) {
+            IORequest done = request;
+            done.Result = Transfer(done);
+
+            completion(done);
+        }
+    }
+
+    const char* GetName() const override {
+        return "pread";
+    }
+};
+
+#ifdef CRAFTMINE_LIBURING
+// Keeps up to a ring of requests in flight. Submitters share the submission
+// queue under the mutex, the completion thread reaps the completion queue and
+// calls the completions. A ring that fails is never submitted to again, its
+// requests and every later one are done with pread and pwrite instead.
+class UringIOBackend : public IOBackend {
+public:
+    ~UringIOBackend() override {
+        if(!m_Initialized) {
+            return;
+        }
+
+        {
+            // every submitted request still completes through its callback
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Changed.wait(lock, [this] { return m_Submitted.empty(); });
+
+            m_Stopping = true;
+        }
+
+        m_Changed.notify_all();
+        m_Thread.join();
+
+        io_uring_queue_exit(&m_Ring);
+    }
+
+    // fails on kernels without io_uring or where it is disabled
+    bool Init() {
+        m_Initialized = io_uring_queue_init(s_QueueDepth, &m_Ring, 0) == 0;
+
+        if(m_Initialized) {
+            m_Thread = std::thread(&UringIOBackend::Run, this);
+        }
+
+        return m_Initialized;
+    }
+
+    void Submit(const std::vector<IORequest>& requests, const IOCompletion& completion) override {
+        if(requests.empty()) {
+            return;
+        }
+
+        size_t count = requests.size();
+
+        // freed by whichever thread finishes its last request
+        Batch* batch = new Batch();
+        batch->Completion = completion;
+        batch->Operations.resize(count);
+        batch->Remaining = count;
+
+        for(size_t i = 0; i < count; i++) {
+            batch->Operations[i].Request = requests[i];
+            batch->Operations[i].Owner = batch;
+        }
+
+        size_t next = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+
+            while(next < count && !m_Failed) {
+                // no more requests in flight than the ring holds, so the completion queue never overflows
+                m_Changed.wait(lock, [this] { return m_Submitted.size() < s_QueueDepth || m_Failed; });
+
+                if(m_Failed) {
+                    break;
+                }
+
+                size_t prepared = 0;
+
+                while(next + prepared < count && m_Submitted.size() + prepared < s_QueueDepth) {
+                    io_uring_sqe* sqe = io_uring_get_sqe(&m_Ring);
+
+                    if(!sqe) {
+                        break;
+                    }
+
+                    Prepare(sqe, batch->Operations[next + prepared]);
+                    prepared++;
+                }
+
+                size_t submitted = SubmitPrepared(prepared);
+
+                for(size_t i = next; i < next + submitted; i++) {
+                    m_Submitted.insert(&batch->Operations[i]);
+                }
+
+                next += submitted;
+
+                // entries left in the queue are never submitted, their requests are done below
+                if(submitted < prepared) {
+                    m_Failed = true;
+                }
+
+                m_Changed.notify_all();
+            }
+        }
+
+        for(size_t i = next; i < count; i++) {
+            Operation& operation = batch->Operations[i];
+            operation.Request.Result = Transfer(operation.Request);
+
+            Finish(operation);
+        }
+    }
+
+    const char* GetName() const override {
+        return "io_uring";
+    }
+private:
+    struct Batch;
+
+    struct Operation {
+        IORequest Request;
+        Batch* Owner = nullptr;
+    };
+
+    struct Batch {
+        std::vector<Operation> Operations;
+        IOCompletion Completion;
+        std::atomic<size_t> Remaining = 0;
+    };
+
+    void Run() {
+        while(true) {
+            {
+                // a completion is only waited for while the kernel owes one
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Changed.wait(lock, [this] { return !m_Submitted.empty() || m_Stopping; });
+
+                if(m_Submitted.empty()) {
+                    return;
+                }
+            }
+
+            io_uring_cqe* cqe = nullptr;
+            int result = io_uring_wait_cqe(&m_Ring, &cqe);
+
+            if(result == -EINTR) {
+                continue;
+            }
+
+            if(result < 0) {
+                std::cerr << "Failed to wait for I/O completions: " << strerror(-result) << ", falling back to pread" << std::endl;
+
+                FailSubmitted();
+                continue;
+            }
+
+            Operation& operation = *static_cast<Operation*>(io_uring_cqe_get_data(cqe));
+            int64_t transferred = cqe->res;
+
+            io_uring_cqe_seen(&m_Ring, cqe);
+
+            // a short or failed transfer is done again with pread or pwrite, which retry and report the error
+            operation.Request.Result = transferred == static_cast<int64_t>(operation.Request.Size) ? transferred : Transfer(operation.Request);
+
+            Finish(operation);
+        }
+    }
+
+    static void Prepare(io_uring_sqe* sqe, Operation& operation) {
+        const IORequest& request = operation.Request;
+
+        if(request.Type == IOType::READ) {
+            io_uring_prep_read(sqe, static_cast<int>(request.File), request.Buffer, static_cast<unsigned>(request.Size), request.Offset);
+        } else {
+            io_uring_prep_write(sqe, static_cast<int>(request.File), request.Buffer, static_cast<unsigned>(request.Size), request.Offset);
+        }
+
+        io_uring_sqe_set_data(sqe, &operation);
+    }
+
+    // the kernel can take part of the queue at a time, returns how many entries it took, mutex has to be held
+    size_t SubmitPrepared(size_t count) {
+        size_t submitted = 0;
+        int retries = 0;
+
+        while(submitted < count) {
+            int result = io_uring_submit(&m_Ring);
+
+            if(result == -EINTR || ((result == -EAGAIN || result == -EBUSY) && retries++ < s_MaxSubmitRetries)) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            if(result <= 0) {
+                std::cerr << "Failed to submit I/O requests: " << strerror(result < 0 ? -result : EIO) << ", falling back to pread" << std::endl;
+                break;
+            }
+
+            submitted += static_cast<size_t>(result);
+        }
+
+        return submitted;
+    }
+
+    // requests the ring may never complete are done with pread and pwrite
+    void FailSubmitted() {
+        std::vector<Operation*> operations;
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            m_Failed = true;
+            operations.assign(m_Submitted.begin(), m_Submitted.end());
+        }
+
+        m_Changed.notify_all();
+
+        for(Operation* operation : operations) {
+            operation->Request.Result = Transfer(operation->Request);
+            Finish(*operation);
+        }
+    }
+
+    void Finish(Operation& operation) {
+        Batch* batch = operation.Owner;
+        batch->Completion(operation.Request);
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Submitted.erase(&operation);
+        }
+
+        m_Changed.notify_all();
+
+        if(--batch->Remaining == 0) {
+            delete batch;
+        }
+    }
+private:
+    io_uring m_Ring;
+    bool m_Initialized = false;
+
+    std::thread m_Thread;
+
+    // guards the submission queue and everything below, never held while waiting for completions
+    std::mutex m_Mutex;
+    std::condition_variable m_Changed;
+
+    // requests the kernel took and has not completed yet
+    std::unordered_set<Operation*> m_Submitted;
+
+    bool m_Failed = false;
+    bool m_Stopping = false;
+
+    // a frame of saved chunk reads rarely goes past this
+    static const unsigned s_QueueDepth = 64;
+
+    // a kernel short of resources gets this many tries before the backend falls back to pread
+    static const int s_MaxSubmitRetries = 16;
+};
+#endif
+
+void IOBackend::Execute(std::vector<IORequest>& requests) {
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t remaining = requests.size();
+
+    std::vector<IORequest> batch = requests;
+
+    for(size_t i = 0; i < batch.size(); i++) {
+        batch[i].UserData = i;
+    }
+
+    Submit(batch, [&](const IORequest& request) {
+        std::lock_guard<std::mutex> lock(mutex);
+        requests[request.UserData].Result = request.Result;
+
+        if(--remaining == 0) {
+            done.notify_one();
+        }
+    });
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return remaining == 0; });
+}
+
+std::unique_ptr<IOBackend> IOBackend::Create(IOBackendType type) {
+#ifdef CRAFTMINE_LIBURING
+    if(type != IOBackendType::POSITIONAL) {
+        auto uring = std::make_unique<UringIOBackend>();
+
+        if(uring->Init()) {
+            return uring;
+        }
+
+        std::cerr << "io_uring is not available, falling back to pread" << std::endl;
+    }
+#else
+    if(type == IOBackendType::URING) {
+        std::cerr << "io_uring is not built in, falling back to pread" << std::endl;
+    }
+#endif
+
+    return std::make_unique<PositionalIOBackend>();
+}
+
+intptr_t IOBackend::Open(const std::filesystem::path& path) {
+#ifdef _WIN32
+    // readers map the file with their own handle, so it stays shared
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    return file == INVALID_HANDLE_VALUE ? s_InvalidFile : reinterpret_cast<intptr_t>(file);
+#else
+    int file = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+
+    return file < 0 ? s_InvalidFile : file;
+#endif
+}
+
+void IOBackend::Close(intptr_t file) {
+    if(file == s_InvalidFile) {
+        return;
+    }
+
+#ifdef _WIN32
+    CloseHandle(reinterpret_cast<HANDLE>(file));
+#else
+    close(static_cast<int>(file));
+#endif
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <filesystem>
+
+enum class IOType {
+    READ,
+    WRITE
+};
+
+enum class IOBackendType {
+    AUTO,
+    POSITIONAL,
+    URING
+};
+
+// one positional read or write, the file offset is never moved
+struct IORequest {
+    IOType Type = IOType::READ;
+    intptr_t File = -1;
+    uint64_t Offset = 0;
+    uint8_t* Buffer = nullptr;
+    size_t Size = 0;
+
+    // bytes transferred once executed, negative on failure
+    int64_t Result = 0;
+
+    // passed back untouched, tells the completion which request it got
+    uint64_t UserData = 0;
+};
+
+// called once for every request of a submission, with its result filled in
+using IOCompletion = std::function<void(const IORequest& request)>;
+
+// Reads and writes files at explicit offsets. Submit hands a batch to the
+// backend and every request comes back through the completion once it is
+// done. The io_uring backend submits a batch with one system call and a
+// thread of its own calls the completions as the kernel finishes the
+// requests, so the reads of a batch are in flight together and the caller
+// does not wait for them. The positional backend runs pread and pwrite (or
+// ReadFile and WriteFile at an offset on Windows) one after the other and
+// calls the completions before Submit returns. Both can be used from any
+// thread.
+class IOBackend {
+public:
+    virtual ~IOBackend() = default;
+
+    // requests complete in any order, their buffers have to stay valid until then,
+    // dependent writes go in separate submissions
+    virtual void Submit(const std::vector<IORequest>& requests, const IOCompletion& completion) = 0;
+
+    // submits the batch and waits for all of it, the results are stored in the requests
+    void Execute(std::vector<IORequest>& requests);
+
+    virtual const char* GetName() const = 0;
+
+    // AUTO is io_uring when it was built in and the kernel supports it, every backend falls back to positional reads and writes
+    static std::unique_ptr<IOBackend> Create(IOBackendType type = IOBackendType::AUTO);
+
+    // opened for reading and writing, created if missing, s_InvalidFile on failure
+    static intptr_t Open(const std::filesystem::path& path);
+    static void Close(intptr_t file);
+public:
+    static const intptr_t s_InvalidFile = -1;
+};
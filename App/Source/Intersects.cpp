@@ -137,6 +137,59 @@ namespace Intersects {
         return false;
     }
 
+    bool RayVoxel(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float maxDistance, const VoxelFn& solid, VoxelHit& hit) {
+        // Amanatides & Woo traversal, blocks are centered on integer positions,
+        // so the grid is shifted by half a block to put cell borders on integers
+        glm::vec3 origin = rayOrigin + glm::vec3(0.5f);
+        glm::vec3 direction = glm::normalize(rayDirection);
+
+        glm::ivec3 cell = glm::ivec3(glm::floor(origin));
+        glm::ivec3 step(0);
+
+        glm::vec3 tMax(FLT_MAX); // distance to the next cell border on each axis
+        glm::vec3 tDelta(FLT_MAX); // distance between cell borders on each axis
+
+        for(int i = 0; i < 3; i++) {
+            if(direction[i] > 0.0f) {
+                step[i] = 1;
+                tMax[i] = (cell[i] + 1.0f - origin[i]) / direction[i];
+                tDelta[i] = 1.0f / direction[i];
+            } else if(direction[i] < 0.0f) {
+                step[i] = -1;
+                tMax[i] = (origin[i] - cell[i]) / -direction[i];
+                tDelta[i] = -1.0f / direction[i];
+            }
+        }
+
+        float t = 0.0f;
+        glm::vec3 normal(0.0f);
+
+        while(t <= maxDistance) {
+            if(solid(cell)) {
+                hit.Cell = cell;
+                hit.Normal = normal;
+                hit.T = t;
+
+                return true;
+            }
+
+            // step into the closest neighbor cell
+            int axis = 0;
+
+            if(tMax[1] < tMax[axis]) axis = 1;
+            if(tMax[2] < tMax[axis]) axis = 2;
+
+            cell[axis] += step[axis];
+            t = tMax[axis];
+            tMax[axis] += tDelta[axis];
+
+            normal = glm::vec3(0.0f);
+            normal[axis] = static_cast<float>(-step[axis]);
+        }
+
+        return false;
+    }
+
     bool AABBFrustum(const Frustum& frustum, const AABB& box) {
         for(int i = 0; i < 6; i++) {
             const Face& p = frustum.Faces[i];
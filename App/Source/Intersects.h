@@ -4,6 +4,7 @@
 
 #include <numeric>
 #include <algorithm>
+#include <functional>
 
 namespace Intersects {
 
@@ -38,9 +39,19 @@ namespace Intersects {
         glm::vec3 Normal = glm::vec3(0.0f, 0.0f, 0.0f);
     };
 
+    struct VoxelHit {
+        glm::ivec3 Cell = glm::ivec3(0); // block position
+        glm::vec3 Normal = glm::vec3(0.0f); // normal of the entered face, zero if the ray starts inside the block
+        float T = 0.0f; // distance along the ray
+    };
+
+    // returns true for cells that stop the ray
+    using VoxelFn = std::function<bool(const glm::ivec3& cell)>;
+
     Frustum GetFrustumFromViewProjectionMatrix(const glm::mat4& matrix);
     bool RayAABB(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, const AABB& boundBox, float& tNear);
     bool RayFace(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, const glm::mat4& model, FaceHit& hit);
+    bool RayVoxel(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float maxDistance, const VoxelFn& solid, VoxelHit& hit);
     bool AABBFrustum(const Frustum& frustum, const AABB& box);
 
 }
\ No newline at end of file
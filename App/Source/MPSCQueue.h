@@ -0,0 +1,103 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <utility>
+
+// Unbounded lock-free queue for many producers and a single consumer.
+// Producers swap themselves in as the head with one atomic exchange and link
+// the previous head to the new node; the consumer walks the links from a stub
+// node. A producer interrupted between the two steps only delays Pop, the
+// queue never loses an item. Popped nodes go to a free list Push takes from
+// first, so a queue that has grown to its working size stops allocating.
+template<typename T>
+class MPSCQueue {
+public:
+    MPSCQueue() {
+        Node* stub = new Node();
+
+        m_Head.store(stub, std::memory_order_relaxed);
+        m_Tail = stub;
+    }
+
+    ~MPSCQueue() {
+        T value;
+
+        while(Pop(value)) {
+        }
+
+        delete m_Tail;
+
+        while(m_Free) {
+            Node* node = m_Free;
+            m_Free = node->Next.load(std::memory_order_relaxed);
+
+            delete node;
+        }
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    // any thread
+    void Push(T value) {
+        Node* node = AcquireNode();
+        node->Value = std::move(value);
+
+        Node* previous = m_Head.exchange(node, std::memory_order_acq_rel);
+        previous->Next.store(node, std::memory_order_release);
+    }
+
+    // consumer thread only
+    bool Pop(T& value) {
+        Node* tail = m_Tail;
+        Node* next = tail->Next.load(std::memory_order_acquire);
+
+        if(next == nullptr) {
+            return false;
+        }
+
+        // next becomes the new stub, its value is moved out
+        value = std::move(next->Value);
+        m_Tail = next;
+
+        ReleaseNode(tail);
+
+        return true;
+    }
+private:
+    struct Node {
+        std::atomic<Node*> Next = nullptr;
+        T Value;
+    };
+
+    Node* AcquireNode() {
+        {
+            std::lock_guard<std::mutex> lock(m_FreeMutex);
+
+            if(Node* node = m_Free) {
+                m_Free = node->Next.load(std::memory_order_relaxed);
+                node->Next.store(nullptr, std::memory_order_relaxed);
+
+                return node;
+            }
+        }
+
+        return new Node();
+    }
+
+    // the node's value was moved out when it became the stub
+    void ReleaseNode(Node* node) {
+        std::lock_guard<std::mutex> lock(m_FreeMutex);
+
+        node->Next.store(m_Free, std::memory_order_relaxed);
+        m_Free = node;
+    }
+private:
+    std::atomic<Node*> m_Head;
+    Node* m_Tail;
+
+    // popped nodes linked through Next, the lock is only held to take or return one
+    Node* m_Free = nullptr;
+    std::mutex m_FreeMutex;
+};
@@ -3,14 +3,46 @@
 #include "AppLayer.h"
 #include "HUDLayer.h"
 
-int main() {
+#include <string>
+#include <charconv>
+#include <optional>
+#include <iostream>
+#include <string.h>
+
+int main(int argc, char** argv) {
+    // a new world is generated from --seed, an existing one keeps the seed it was created with
+    std::optional<uint32_t> seed;
+
+    for(int i = 1; i < argc; i++) {
+        if(std::string(argv[i]) == "--seed") {
+            if(i + 1 == argc) {
+                std::cerr << "Invalid seed: missing value (expected a number from 0 to 4294967295)" << std::endl;
+                return 1;
+            }
+
+            const char* text = argv[++i];
+            const char* end = text + strlen(text);
+
+            // the whole argument has to be digits that fit uint32_t, "-1" or 2^32 would wrap around
+            uint32_t value = 0;
+            auto [last, error] = std::from_chars(text, end, value);
+
+            if(error != std::errc() || last != end) {
+                std::cerr << "Invalid seed: " << text << " (expected a number from 0 to 4294967295)" << std::endl;
+                return 1;
+            }
+
+            seed = value;
+        }
+    }
+
     Core::ApplicationParams appParams;
     appParams.Name = "CraftMine";
     appParams.WindowParams.Width = 1280;
     appParams.WindowParams.Height = 720;
 
     Core::Application app(appParams);
-    app.PushLayer<AppLayer>();
+    app.PushLayer<AppLayer>(seed);
     app.PushLayer<HUDLayer>();
     app.Run();
 
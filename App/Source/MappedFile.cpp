@@ -0,0 +1,158 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#include <algorithm>
+
+MappedFile::MappedFile() {
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+bool MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+
+#ifdef _WIN32
+    // writers keep their own handle, so the file stays shared for writing
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if(file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+
+    if(!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    m_File = file;
+    m_Size = static_cast<size_t>(size.QuadPart);
+    m_Open = true;
+
+    // a mapping of an empty file cannot be created
+    if(m_Size == 0) {
+        return true;
+    }
+
+    m_Mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if(m_Mapping) {
+        m_Data = static_cast<const uint8_t*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    int file = open(path.c_str(), O_RDONLY);
+
+    if(file < 0) {
+        return false;
+    }
+
+    struct stat status;
+
+    if(fstat(file, &status) != 0) {
+        close(file);
+        return false;
+    }
+
+    m_File = file;
+    m_Size = static_cast<size_t>(status.st_size);
+    m_Open = true;
+
+    // a mapping of an empty file cannot be created
+    if(m_Size == 0) {
+        return true;
+    }
+
+    void* data = mmap(nullptr, m_Size, PROT_READ, MAP_SHARED, file, 0);
+
+    if(data != MAP_FAILED) {
+        m_Data = static_cast<const uint8_t*>(data);
+    }
+#endif
+
+    if(!m_Data) {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void MappedFile::Close() {
+#ifdef _WIN32
+    if(m_Data) {
+        UnmapViewOfFile(m_Data);
+    }
+
+    if(m_Mapping) {
+        CloseHandle(m_Mapping);
+    }
+
+    if(m_File) {
+        CloseHandle(m_File);
+    }
+
+    m_Mapping = nullptr;
+    m_File = nullptr;
+#else
+    if(m_Data) {
+        munmap(const_cast<uint8_t*>(m_Data), m_Size);
+    }
+
+    if(m_File >= 0) {
+        close(m_File);
+    }
+
+    m_File = -1;
+#endif
+
+    m_Data = nullptr;
+    m_Size = 0;
+    m_Open = false;
+}
+
+bool MappedFile::IsOpen() const {
+    return m_Open;
+}
+
+const uint8_t* MappedFile::GetData() const {
+    return m_Data;
+}
+
+size_t MappedFile::GetSize() const {
+    return m_Size;
+}
+
+void MappedFile::Prefetch(size_t offset, size_t size) const {
+    if(!m_Data || offset >= m_Size) {
+        return;
+    }
+
+    size = std::min(size, m_Size - offset);
+
+#ifdef _WIN32
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = const_cast<uint8_t*>(m_Data + offset);
+    range.NumberOfBytes = size;
+
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    // madvise wants a page aligned start
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t start = offset & ~(pageSize - 1);
+
+    madvise(const_cast<uint8_t*>(m_Data + start), size + (offset - start), MADV_WILLNEED);
+#endif
+}
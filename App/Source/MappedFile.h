@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <filesystem>
+
+// Read-only view of a whole file mapped into memory, so data is decoded
+// straight from the page cache instead of being copied through a stream.
+// The view is a snapshot of the file size when it was opened, data written
+// past it later needs the file to be opened again.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // an empty file opens with no data
+    bool Open(const std::filesystem::path& path);
+    void Close();
+
+    bool IsOpen() const;
+
+    const uint8_t* GetData() const;
+    size_t GetSize() const;
+
+    // asks the OS to read the range ahead in the background
+    void Prefetch(size_t offset, size_t size) const;
+private:
+    const uint8_t* m_Data = nullptr;
+    size_t m_Size = 0;
+
+    bool m_Open = false;
+
+#ifdef _WIN32
+    void* m_File = nullptr;
+    void* m_Mapping = nullptr;
+#else
+    int m_File = -1;
+#endif
+};
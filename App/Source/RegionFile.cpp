@@ -0,0 +1,171 @@
+#include "RegionFile.h"
+
+#include <string.h>
+#include <iostream>
+
+RegionFile::RegionFile(const std::filesystem::path& path, IOBackend& io)
+    : m_IO(io) {
+    m_Path = path;
+    m_Table.fill({});
+
+    m_File = IOBackend::Open(m_Path);
+
+    if(!IsOpen()) {
+        std::cerr << "Failed to open region file: " << m_Path.string() << std::endl;
+        return;
+    }
+
+    // a new (or truncated) file starts with an empty table
+    if(!m_Mapping.Open(m_Path) || m_Mapping.GetSize() < sizeof(m_Table)) {
+        std::vector<IORequest> requests = {
+            { IOType::WRITE, m_File, 0, reinterpret_cast<uint8_t*>(m_Table.data()), sizeof(m_Table) }
+        };
+
+        m_IO.Execute(requests);
+
+        m_Mapping.Open(m_Path);
+    } else {
+        memcpy(m_Table.data(), m_Mapping.GetData(), sizeof(m_Table));
+    }
+
+    SetSectorsUsed(0, s_TableSectors, true);
+
+    uint64_t fileSectors = (m_Mapping.GetSize() + s_SectorSize - 1) / s_SectorSize;
+
+    // sectors no entry points to are free, including those of chunks that were moved,
+    // a damaged entry pointing past the end of the file must not grow the map
+    for(const auto& entry : m_Table) {
+        if(entry.Offset >= s_TableSectors && entry.Size <= s_MaxChunkSize && static_cast<uint64_t>(entry.Offset) + GetSectorCount(entry.Size) <= fileSectors) {
+            SetSectorsUsed(entry.Offset, GetSectorCount(entry.Size), true);
+        }
+    }
+}
+
+RegionFile::~RegionFile() {
+    IOBackend::Close(m_File);
+}
+
+bool RegionFile::IsOpen() const {
+    return m_File != IOBackend::s_InvalidFile;
+}
+
+bool RegionFile::Contains(glm::ivec2 chunk) const {
+    return m_Table[GetEntryIndex(chunk)].Offset != 0;
+}
+
+bool RegionFile::Locate(glm::ivec2 chunk, uint64_t& offset, size_t& size) const {
+    const Entry& entry = m_Table[GetEntryIndex(chunk)];
+
+    if(!IsOpen() || entry.Offset == 0) {
+        return false;
+    }
+
+    // a damaged table must not make the chunk read the table itself or a huge buffer
+    if(entry.Offset < s_TableSectors || entry.Size > s_MaxChunkSize) {
+        std::cerr << "Invalid region file entry for chunk " << chunk.x << ", " << chunk.y << std::endl;
+        return false;
+    }
+
+    offset = static_cast<uint64_t>(entry.Offset) * s_SectorSize;
+    size = entry.Size;
+
+    return true;
+}
+
+bool RegionFile::Write(glm::ivec2 chunk, const std::vector<uint8_t>& data) {
+    if(!IsOpen()) {
+        return false;
+    }
+
+    size_t index = GetEntryIndex(chunk);
+    Entry oldEntry = m_Table[index];
+
+    // the old data stays where it is until the entry points to the new one
+    Entry entry;
+    entry.Offset = FindFreeSectors(GetSectorCount(data.size()));
+    entry.Size = static_cast<uint32_t>(data.size());
+
+    // data goes first, in its own batch, so the table never points to data that was not written
+    std::vector<IORequest> requests = {
+        { IOType::WRITE, m_File, static_cast<uint64_t>(entry.Offset) * s_SectorSize, const_cast<uint8_t*>(data.data()), data.size() }
+    };
+
+    m_IO.Execute(requests);
+
+    if(requests[0].Result == static_cast<int64_t>(data.size())) {
+        requests[0] = { IOType::WRITE, m_File, index * sizeof(Entry), reinterpret_cast<uint8_t*>(&entry), sizeof(Entry) };
+        m_IO.Execute(requests);
+    }
+
+    // the new sectors stay free, the entry on disk still points to the old data
+    if(requests[0].Result != static_cast<int64_t>(requests[0].Size)) {
+        std::cerr << "Failed to write chunk " << chunk.x << ", " << chunk.y << " to region file" << std::endl;
+        return false;
+    }
+
+    if(oldEntry.Offset >= s_TableSectors && oldEntry.Size <= s_MaxChunkSize) {
+        SetSectorsUsed(oldEntry.Offset, GetSectorCount(oldEntry.Size), false);
+    }
+
+    SetSectorsUsed(entry.Offset, GetSectorCount(entry.Size), true);
+
+    m_Table[index] = entry;
+
+    return true;
+}
+
+intptr_t RegionFile::GetFile() const {
+    return m_File;
+}
+
+void RegionFile::Prefetch(glm::ivec2 chunk) {
+    const Entry& entry = m_Table[GetEntryIndex(chunk)];
+
+    if(entry.Offset >= s_TableSectors && entry.Size <= s_MaxChunkSize) {
+        m_Mapping.Prefetch(static_cast<size_t>(entry.Offset) * s_SectorSize, entry.Size);
+    }
+}
+
+glm::ivec2 RegionFile::GetRegion(glm::ivec2 chunk) {
+    // floor division, so negative chunks land in negative regions
+    return {
+        chunk.x >= 0 ? chunk.x / s_RegionSize : (chunk.x + 1) / s_RegionSize - 1,
+        chunk.y >= 0 ? chunk.y / s_RegionSize : (chunk.y + 1) / s_RegionSize - 1
+    };
+}
+
+uint32_t RegionFile::FindFreeSectors(uint32_t count) const {
+    uint32_t first = s_TableSectors;
+    uint32_t length = 0;
+
+    for(uint32_t sector = s_TableSectors; sector < m_UsedSectors.size() && length < count; sector++) {
+        if(m_UsedSectors[sector]) {
+            first = sector + 1;
+            length = 0;
+        } else {
+            length++;
+        }
+    }
+
+    // a run of free sectors at the end of the file is extended past it
+    return first;
+}
+
+void RegionFile::SetSectorsUsed(uint32_t first, uint32_t count, bool used) {
+    if(m_UsedSectors.size() < static_cast<size_t>(first) + count) {
+        m_UsedSectors.resize(static_cast<size_t>(first) + count, false);
+    }
+
+    for(uint32_t sector = first; sector < first + count; sector++) {
+        m_UsedSectors[sector] = used;
+    }
+}
+
+size_t RegionFile::GetEntryIndex(glm::ivec2 chunk) {
+    // region size is a power of two, masking wraps negative coordinates too
+    return static_cast<size_t>(chunk.y & (s_RegionSize - 1)) * s_RegionSize + static_cast<size_t>(chunk.x & (s_RegionSize - 1));
+}
+
+uint32_t RegionFile::GetSectorCount(size_t bytes) {
+    return static_cast<uint32_t>((bytes + s_SectorSize - 1) / s_SectorSize);
+}
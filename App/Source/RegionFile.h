@@ -0,0 +1,75 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "IOBackend.h"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <vector>
+#include <stdint.h>
+#include <filesystem>
+
+// One file holding the saved chunks of a 32x32 chunk region. The file starts
+// with a table telling where every chunk's data is and how long it is, and
+// the data follows in 4 KB sectors. A chunk is never rewritten in place: its
+// new data goes to free sectors first and only then is its table entry
+// switched to them, so a write cut short leaves the old data readable. The
+// sectors the chunk used before are freed for later writes, free sectors are
+// found again from the table when the file is opened. Chunk data is read and
+// written through the I/O backend at the offsets the table gives, the memory
+// mapping is only used to load the table and to prefetch. The file is not
+// synchronized.
+class RegionFile {
+public:
+    RegionFile(const std::filesystem::path& path, IOBackend& io);
+    ~RegionFile();
+
+    bool IsOpen() const;
+
+    // chunk coordinates are world chunk keys
+    bool Contains(glm::ivec2 chunk) const;
+
+    // where the saved chunk is in the file, false if the chunk was never written,
+    // reads of a batch are built from it and executed by the owner of the backend
+    bool Locate(glm::ivec2 chunk, uint64_t& offset, size_t& size) const;
+    bool Write(glm::ivec2 chunk, const std::vector<uint8_t>& data);
+
+    intptr_t GetFile() const;
+
+    // pages the saved chunk in the background, so reading it later does not wait for the disk
+    void Prefetch(glm::ivec2 chunk);
+
+    // region the chunk is in
+    static glm::ivec2 GetRegion(glm::ivec2 chunk);
+public:
+    static const int s_RegionSize = 32;
+private:
+    struct Entry {
+        uint32_t Offset = 0; // in sectors, 0 when the chunk has no data
+        uint32_t Size = 0; // in bytes
+    };
+
+    // first run of free sectors long enough, past the end of the file when there is none
+    uint32_t FindFreeSectors(uint32_t count) const;
+    void SetSectorsUsed(uint32_t first, uint32_t count, bool used);
+
+    static size_t GetEntryIndex(glm::ivec2 chunk);
+    static uint32_t GetSectorCount(size_t bytes);
+private:
+    std::filesystem::path m_Path;
+
+    IOBackend& m_IO;
+    intptr_t m_File = IOBackend::s_InvalidFile;
+
+    MappedFile m_Mapping;
+
+    std::array<Entry, s_RegionSize * s_RegionSize> m_Table;
+
+    // one flag per sector of the file, the table sectors are always used
+    std::vector<bool> m_UsedSectors;
+
+    static const size_t s_SectorSize = 4096;
+    static const size_t s_MaxChunkSize = 1024 * 1024;
+    static const uint32_t s_TableSectors = static_cast<uint32_t>((sizeof(Entry) * s_RegionSize * s_RegionSize + s_SectorSize - 1) / s_SectorSize);
+};
@@ -0,0 +1,45 @@
+#include "WorldGenerator.h"
+#include "Chunk.h"
+
+#include <cmath>
+
+WorldGenerator::WorldGenerator(uint32_t seed)
+    : m_Seed(seed), m_Perlin(seed) {
+}
+
+WorldGenerator::~WorldGenerator() {
+
+}
+
+uint32_t WorldGenerator::GetSeed() const {
+    return m_Seed;
+}
+
+float WorldGenerator::GetTerrainNoise(float x, float z) const {
+    return SampleNoise(x, z, s_TerrainScale, s_TerrainOctaves, s_TerrainPersistence);
+}
+
+int WorldGenerator::GetTerrainHeight(float noise) {
+    // terrain height is between 32 and 80 blocks
+    return static_cast<int>(std::floor(noise * Chunk::s_ChunkSize * 3 + Chunk::s_ChunkSize * 2));
+}
+
+bool WorldGenerator::HasTree(float x, float z) const {
+    return SampleNoise(x, z, s_TreeScale, s_TreeOctaves, s_TreePersistence) > s_TreeThreshold;
+}
+
+float WorldGenerator::SampleNoise(float x, float z, float scale, int octaves, float persistence) const {
+    double amplitude = 1.0;
+    double freequency = 1.0;
+    double noiseValue = 0.0;
+
+    for(int o = 0; o < octaves; o++) {
+        noiseValue += amplitude * m_Perlin.Noise(x * scale * freequency, z * scale * freequency, 0.0);
+
+        amplitude *= persistence;
+        freequency *= 2.0;
+    }
+
+    // normalize to [0, 1]
+    return (float)((noiseValue + 1.0) / 2.0);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Perlin.h"
+
+#include <stdint.h>
+
+// Noise the terrain and the decorations of a world are generated from. The
+// permutation table is shuffled from the seed once, in the constructor, and
+// only read afterwards, so one instance is shared by every worker without
+// locking. Chunks run the stages themselves: terrain noise gives the height
+// of each column, and tree noise decides which columns get a tree.
+class WorldGenerator {
+public:
+    WorldGenerator(uint32_t seed);
+    ~WorldGenerator();
+
+    uint32_t GetSeed() const;
+
+    // terrain stage, normalized noise of a column in world coordinates
+    float GetTerrainNoise(float x, float z) const;
+    static int GetTerrainHeight(float noise);
+
+    // decoration stage, true when a tree is rooted on top of the column
+    bool HasTree(float x, float z) const;
+private:
+    // octaves of Perlin noise, normalized to [0, 1]
+    float SampleNoise(float x, float z, float scale, int octaves, float persistence) const;
+private:
+    uint32_t m_Seed = 0;
+    Perlin m_Perlin;
+
+    static constexpr float s_TerrainScale = 0.01f;
+    static const int s_TerrainOctaves = 4;
+    static constexpr float s_TerrainPersistence = 0.5f;
+
+    static constexpr float s_TreeScale = 0.6f;
+    static const int s_TreeOctaves = 4;
+    static constexpr float s_TreePersistence = 0.1f;
+    static constexpr float s_TreeThreshold = 0.75f;
+};
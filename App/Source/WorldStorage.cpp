@@ -0,0 +1,342 @@
+#include "WorldStorage.h"
+
+#include <format>
+#include <fstream>
+#include <iostream>
+
+WorldStorage::WorldStorage(const std::filesystem::path& directory, IOBackendType backend) {
+    m_Directory = directory;
+    m_IO = IOBackend::Create(backend);
+
+    std::error_code error;
+    std::filesystem::create_directories(m_Directory, error);
+
+    if(error) {
+        std::cerr << "Failed to create world directory: " << m_Directory.string() << std::endl;
+    }
+}
+
+WorldStorage::~WorldStorage() {
+    WaitForLoads();
+    FlushAll();
+}
+
+void WorldStorage::Save(glm::ivec2 chunk, std::vector<uint8_t> data) {
+    auto pending = std::make_shared<const std::vector<uint8_t>>(std::move(data));
+
+    std::lock_guard<std::mutex> lock(m_PendingMutex);
+    m_Pending[GetKey(chunk)] = std::move(pending);
+}
+
+void WorldStorage::Load(std::vector<ChunkRead>& reads) {
+    {
+        std::lock_guard<std::mutex> lock(m_PendingMutex);
+
+        for(auto& read : reads) {
+            read.Found = false;
+
+            if(auto it = m_Pending.find(GetKey(read.Chunk)); it != m_Pending.end()) {
+                read.Data = *it->second;
+                read.Found = true;
+            }
+        }
+    }
+
+    // a flush finishing in between has already written the data when the file mutex is free
+    std::lock_guard<std::mutex> lock(m_FileMutex);
+
+    std::vector<IORequest> requests;
+    std::vector<ChunkRead*> targets;
+
+    for(auto& read : reads) {
+        RegionFile* file = read.Found ? nullptr : FindRegionFile(read.Chunk);
+
+        uint64_t offset = 0;
+        size_t size = 0;
+
+        if(!file || !file->Locate(read.Chunk, offset, size)) {
+            continue;
+        }
+
+        read.Data.resize(size);
+
+        requests.push_back({ IOType::READ, file->GetFile(), offset, read.Data.data(), size });
+        targets.push_back(&read);
+    }
+
+    m_IO->Execute(requests);
+
+    for(size_t i = 0; i < requests.size(); i++) {
+        if(requests[i].Result == static_cast<int64_t>(requests[i].Size)) {
+            targets[i]->Found = true;
+        } else {
+            std::cerr << "Failed to read chunk " << targets[i]->Chunk.x << ", " << targets[i]->Chunk.y << " from region file" << std::endl;
+        }
+    }
+}
+
+void WorldStorage::Load(std::vector<ChunkRead> reads, const std::function<void(size_t index, ChunkRead& read)>& completion) {
+    // the buffers are read into until the last completion
+    auto batch = std::make_shared<std::vector<ChunkRead>>(std::move(reads));
+
+    // chunks with queued data or never saved complete without the disk
+    std::vector<size_t> completed;
+
+    {
+        std::lock_guard<std::mutex> lock(m_PendingMutex);
+
+        for(size_t i = 0; i < batch->size(); i++) {
+            ChunkRead& read = (*batch)[i];
+            read.Found = false;
+
+            if(auto it = m_Pending.find(GetKey(read.Chunk)); it != m_Pending.end()) {
+                read.Data = *it->second;
+                read.Found = true;
+            }
+        }
+    }
+
+    {
+        // a flush finishing in between has already written the data when the file mutex is free
+        std::lock_guard<std::mutex> lock(m_FileMutex);
+
+        std::vector<IORequest> requests;
+
+        for(size_t i = 0; i < batch->size(); i++) {
+            ChunkRead& read = (*batch)[i];
+            RegionFile* file = read.Found ? nullptr : FindRegionFile(read.Chunk);
+
+            uint64_t offset = 0;
+            size_t size = 0;
+
+            if(!file || !file->Locate(read.Chunk, offset, size)) {
+                completed.push_back(i);
+                continue;
+            }
+
+            read.Data.resize(size);
+
+            IORequest request = { IOType::READ, file->GetFile(), offset, read.Data.data(), size };
+            request.UserData = i;
+
+            requests.push_back(request);
+        }
+
+        if(!requests.empty()) {
+            std::lock_guard<std::mutex> loadLock(m_LoadMutex);
+            m_LoadsInFlight += requests.size();
+        }
+
+        m_IO->Submit(requests, [this, batch, completion](const IORequest& request) {
+            ChunkRead& read = (*batch)[request.UserData];
+
+            if(request.Result == static_cast<int64_t>(request.Size)) {
+                read.Found = true;
+            } else {
+                std::cerr << "Failed to read chunk " << read.Chunk.x << ", " << read.Chunk.y << " from region file" << std::endl;
+                read.Data.clear();
+            }
+
+            completion(request.UserData, read);
+
+            std::lock_guard<std::mutex> lock(m_LoadMutex);
+
+            if(--m_LoadsInFlight == 0) {
+                m_LoadsDone.notify_all();
+            }
+        });
+    }
+
+    for(size_t index : completed) {
+        completion(index, (*batch)[index]);
+    }
+}
+
+void WorldStorage::WaitForLoads() {
+    std::unique_lock<std::mutex> lock(m_LoadMutex);
+    m_LoadsDone.wait(lock, [this] { return m_LoadsInFlight == 0; });
+}
+
+bool WorldStorage::Contains(glm::ivec2 chunk) {
+    std::lock_guard<std::mutex> lock(m_PendingMutex);
+
+    if(m_Pending.contains(GetKey(chunk)) || !m_IndexedRegions.contains(GetKey(RegionFile::GetRegion(chunk)))) {
+        return true;
+    }
+
+    return m_SavedChunks.contains(GetKey(chunk));
+}
+
+void WorldStorage::Prefetch(glm::ivec2 center, int radius) {
+    std::lock_guard<std::mutex> lock(m_FileMutex);
+
+    for(int z = -radius; z <= radius; z++) {
+        for(int x = -radius; x <= radius; x++) {
+            if(x * x + z * z <= radius * radius) {
+                glm::ivec2 chunk = center + glm::ivec2(x, z);
+
+                if(RegionFile* file = FindRegionFile(chunk)) {
+                    file->Prefetch(chunk);
+                }
+            }
+        }
+    }
+}
+
+bool WorldStorage::Flush(glm::ivec2 chunk) {
+    uint64_t key = GetKey(chunk);
+
+    std::lock_guard<std::mutex> fileLock(m_FileMutex);
+
+    // a rewritten chunk can move into sectors a submitted read has not read yet,
+    // no read is submitted while the file mutex is held
+    WaitForLoads();
+
+    std::shared_ptr<const std::vector<uint8_t>> data;
+
+    {
+        std::lock_guard<std::mutex> lock(m_PendingMutex);
+
+        if(auto it = m_Pending.find(key); it != m_Pending.end()) {
+            data = it->second;
+        }
+    }
+
+    // an earlier flush already wrote the latest data
+    if(!data) {
+        return true;
+    }
+
+    // data that could not be written stays queued, the next flush tries again
+    if(!GetRegionFile(chunk).Write(chunk, *data)) {
+        return false;
+    }
+
+    // data saved again during the write stays queued for the next flush
+    std::lock_guard<std::mutex> lock(m_PendingMutex);
+
+    m_SavedChunks.insert(key);
+
+    if(auto it = m_Pending.find(key); it != m_Pending.end() && it->second == data) {
+        m_Pending.erase(it);
+    }
+
+    return true;
+}
+
+bool WorldStorage::FlushAll() {
+    std::vector<glm::ivec2> chunks;
+
+    {
+        std::lock_guard<std::mutex> lock(m_PendingMutex);
+
+        for(const auto& [key, data] : m_Pending) {
+            chunks.push_back({ static_cast<int32_t>(key >> 32), static_cast<int32_t>(key & 0xFFFFFFFF) });
+        }
+    }
+
+    bool written = true;
+
+    for(const auto& chunk : chunks) {
+        written = Flush(chunk) && written;
+    }
+
+    return written;
+}
+
+size_t WorldStorage::GetPendingCount() {
+    std::lock_guard<std::mutex> lock(m_PendingMutex);
+    return m_Pending.size();
+}
+
+bool WorldStorage::LoadSeed(uint32_t& seed) {
+    std::ifstream file(m_Directory / "seed");
+
+    if(!file.is_open()) {
+        return false;
+    }
+
+    // reported, a world going on with another seed would have its saved chunks out of place
+    if(!(file >> seed)) {
+        std::cerr << "Failed to read world seed: " << (m_Directory / "seed").string() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+void WorldStorage::SaveSeed(uint32_t seed) {
+    std::ofstream file(m_Directory / "seed");
+    file << seed << std::endl;
+
+    if(!file) {
+        std::cerr << "Failed to write world seed: " << (m_Directory / "seed").string() << std::endl;
+    }
+}
+
+const char* WorldStorage::GetBackendName() const {
+    return m_IO->GetName();
+}
+
+RegionFile& WorldStorage::GetRegionFile(glm::ivec2 chunk) {
+    glm::ivec2 region = RegionFile::GetRegion(chunk);
+    std::unique_ptr<RegionFile>& file = m_RegionFiles[GetKey(region)];
+
+    if(!file) {
+        file = std::make_unique<RegionFile>(m_Directory / GetRegionFileName(region), *m_IO);
+        IndexRegion(region, file.get());
+    }
+
+    return *file;
+}
+
+RegionFile* WorldStorage::FindRegionFile(glm::ivec2 chunk) {
+    glm::ivec2 region = RegionFile::GetRegion(chunk);
+
+    if(auto it = m_RegionFiles.find(GetKey(region)); it != m_RegionFiles.end()) {
+        return it->second.get();
+    }
+
+    // regions indexed without being opened have no file
+    {
+        std::lock_guard<std::mutex> lock(m_PendingMutex);
+
+        if(m_IndexedRegions.contains(GetKey(region))) {
+            return nullptr;
+        }
+    }
+
+    // looking for saved chunks must not leave empty region files behind
+    if(!std::filesystem::exists(m_Directory / GetRegionFileName(region))) {
+        IndexRegion(region, nullptr);
+        return nullptr;
+    }
+
+    return &GetRegionFile(chunk);
+}
+
+void WorldStorage::IndexRegion(glm::ivec2 region, const RegionFile* file) {
+    std::lock_guard<std::mutex> lock(m_PendingMutex);
+
+    if(!m_IndexedRegions.insert(GetKey(region)).second || !file) {
+        return;
+    }
+
+    for(int z = 0; z < RegionFile::s_RegionSize; z++) {
+        for(int x = 0; x < RegionFile::s_RegionSize; x++) {
+            glm::ivec2 chunk = region * RegionFile::s_RegionSize + glm::ivec2(x, z);
+
+            if(file->Contains(chunk)) {
+                m_SavedChunks.insert(GetKey(chunk));
+            }
+        }
+    }
+}
+
+std::string WorldStorage::GetRegionFileName(glm::ivec2 region) {
+    return std::format("r.{}.{}.region", region.x, region.y);
+}
+
+uint64_t WorldStorage::GetKey(glm::ivec2 position) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(position.x)) << 32) | static_cast<uint32_t>(position.y);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "RegionFile.h"
+#include "IOBackend.h"
+
+#include <glm/glm.hpp>
+
+#include <mutex>
+#include <string>
+#include <memory>
+#include <vector>
+#include <stdint.h>
+#include <functional>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+#include <condition_variable>
+
+// Saved chunks of the world, kept in region files inside one directory.
+// Saving only queues the data, the file is written by Flush on a worker, so
+// the main thread never waits for the disk. Queued data is returned by Load
+// right away, so a chunk loaded before its save was flushed is not stale.
+// Region files are read and written through the I/O backend. The saved
+// chunks wanted by one frame are submitted as a single batch and handed to a
+// callback one by one as their reads complete, so no thread waits for the
+// disk when the backend is asynchronous. Every method can be called from any
+// thread.
+struct ChunkRead {
+    glm::ivec2 Chunk;
+
+    // filled by Load, Found stays false when the chunk was never saved or could not be read
+    std::vector<uint8_t> Data;
+    bool Found = false;
+};
+
+class WorldStorage {
+public:
+    WorldStorage(const std::filesystem::path& directory, IOBackendType backend = IOBackendType::AUTO);
+    ~WorldStorage();
+
+    void Save(glm::ivec2 chunk, std::vector<uint8_t> data);
+
+    // queued data is copied, the rest is read from the region files as one batch
+    void Load(std::vector<ChunkRead>& reads);
+
+    // same but returns once the batch is submitted, completion is called for every read with
+    // its index in reads, on whichever thread finished it, and must not call back into the storage
+    void Load(std::vector<ChunkRead> reads, const std::function<void(size_t index, ChunkRead& read)>& completion);
+
+    // returns once every read submitted by Load has completed
+    void WaitForLoads();
+
+    // false only when the chunk is known not to be saved, never waits for the disk,
+    // a chunk in a region that was not opened yet may be saved
+    bool Contains(glm::ivec2 chunk);
+
+    // pages in the saved chunks within radius of center, ahead of the jobs loading them
+    void Prefetch(glm::ivec2 center, int radius);
+
+    // writes the queued data of the chunk, if any, false when it could not be written,
+    // the data then stays queued and is written by a later flush
+    bool Flush(glm::ivec2 chunk);
+    // false when any of the chunks queued at the call could not be written
+    bool FlushAll();
+
+    size_t GetPendingCount();
+
+    // seed the world was created with, false for a new world
+    bool LoadSeed(uint32_t& seed);
+    void SaveSeed(uint32_t seed);
+
+    const char* GetBackendName() const;
+private:
+    // opened on first use, file mutex has to be held
+    RegionFile& GetRegionFile(glm::ivec2 chunk);
+
+    // same but regions without a file are not created, nullptr for them
+    RegionFile* FindRegionFile(glm::ivec2 chunk);
+
+    // lists the saved chunks of a newly opened region, file is nullptr for a region without a file
+    void IndexRegion(glm::ivec2 region, const RegionFile* file);
+
+    static std::string GetRegionFileName(glm::ivec2 region);
+    static uint64_t GetKey(glm::ivec2 position);
+private:
+    std::filesystem::path m_Directory;
+
+    // outlives the region files, its batches are serialized by the file mutex
+    std::unique_ptr<IOBackend> m_IO;
+
+    // held while files are read or written, flushes of the same chunk happen in order
+    std::mutex m_FileMutex;
+    std::unordered_map<uint64_t, std::unique_ptr<RegionFile>> m_RegionFiles;
+
+    // only held to look up or swap queued data and the index, never during disk access
+    std::mutex m_PendingMutex;
+    std::unordered_map<uint64_t, std::shared_ptr<const std::vector<uint8_t>>> m_Pending;
+
+    // saved chunks of the opened regions, so Contains does not have to open files
+    std::unordered_set<uint64_t> m_IndexedRegions;
+    std::unordered_set<uint64_t> m_SavedChunks;
+
+    // reads still in flight, a flush must not move sectors they read from
+    std::mutex m_LoadMutex;
+    std::condition_variable m_LoadsDone;
+    size_t m_LoadsInFlight = 0;
+};
@@ -0,0 +1,160 @@
+#include "Chunk.h"
+#include "ChunkSnapshot.h"
+#include "WorldGenerator.h"
+
+#include <array>
+#include <chrono>
+#include <print>
+#include <iostream>
+
+// Compares the palette-compressed block storage of chunks against the dense
+// layout it replaced, one 4-byte BlockType enum per block. Reports the block
+// memory per chunk, and the chunks meshed per second when the meshing
+// snapshot is captured from each layout. The mesher itself only reads the
+// snapshot, so both layouts share its cost.
+
+static const uint32_t s_Seed = 1234567890;
+
+// generated grid, every chunk but the border ones is meshed
+static const int s_GridSize = 7;
+static const int s_Rounds = 10;
+
+static const size_t s_ChunkBlocks = static_cast<size_t>(Chunk::s_ChunkSize) * Chunk::s_ChunkHeight * Chunk::s_ChunkSize;
+
+// the layout before palette storage, indexed y * 256 + z * 16 + x
+using DenseChunk = std::vector<uint32_t>;
+
+static DenseChunk CreateDenseChunk(Chunk& chunk) {
+    DenseChunk blocks(s_ChunkBlocks);
+
+    for(int y = 0; y < Chunk::s_ChunkHeight; y++) {
+        for(int z = 0; z < Chunk::s_ChunkSize; z++) {
+            for(int x = 0; x < Chunk::s_ChunkSize; x++) {
+                blocks[(static_cast<size_t>(y) * Chunk::s_ChunkSize + z) * Chunk::s_ChunkSize + x] = chunk.GetBlockType(glm::vec3(x, y, z));
+            }
+        }
+    }
+
+    return blocks;
+}
+
+// same padded copy ChunkSnapshot::Capture makes, read from dense chunks
+static void CaptureDense(const std::array<const DenseChunk*, 9>& chunks, std::vector<BlockType>& blocks) {
+    const int size = ChunkSnapshot::s_Size;
+
+    for(int y = 0; y < Chunk::s_ChunkHeight; y++) {
+        for(int z = -1; z <= Chunk::s_ChunkSize; z++) {
+            for(int x = -1; x <= Chunk::s_ChunkSize; x++) {
+                int chunkX = x < 0 ? -1 : (x >= Chunk::s_ChunkSize ? 1 : 0);
+                int chunkZ = z < 0 ? -1 : (z >= Chunk::s_ChunkSize ? 1 : 0);
+
+                const DenseChunk& chunk = *chunks[(chunkZ + 1) * 3 + (chunkX + 1)];
+
+                int localX = x - chunkX * Chunk::s_ChunkSize;
+                int localZ = z - chunkZ * Chunk::s_ChunkSize;
+
+                blocks[(static_cast<size_t>(y + 1) * size + (z + 1)) * size + (x + 1)] =
+                    static_cast<BlockType>(chunk[(static_cast<size_t>(y) * Chunk::s_ChunkSize + localZ) * Chunk::s_ChunkSize + localX]);
+            }
+        }
+    }
+}
+
+static double GetSeconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    WorldGenerator generator(s_Seed);
+
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    std::vector<DenseChunk> denseChunks;
+
+    for(int z = 0; z < s_GridSize; z++) {
+        for(int x = 0; x < s_GridSize; x++) {
+            auto chunk = std::make_shared<Chunk>(nullptr, glm::ivec2(x, z), nullptr, nullptr);
+            chunk->SetPosition({ x * Chunk::s_ChunkSize, 0, z * Chunk::s_ChunkSize });
+            chunk->Generate(generator);
+
+            chunks.push_back(chunk);
+        }
+    }
+
+    size_t paletteMemory = 0;
+
+    for(auto& chunk : chunks) {
+        chunk->GenerateDecorations(generator);
+
+        for(int section = 0; section < Chunk::s_SectionCount; section++) {
+            paletteMemory += chunk->GetSection(section).GetMemoryUsage();
+        }
+
+        denseChunks.push_back(CreateDenseChunk(*chunk));
+    }
+
+    size_t denseMemory = s_ChunkBlocks * sizeof(uint32_t);
+
+    std::println("block memory per chunk: palette {} bytes, dense {} bytes ({:.1f}x smaller)",
+                 paletteMemory / chunks.size(), denseMemory, static_cast<double>(denseMemory) * chunks.size() / paletteMemory);
+
+    ChunkSnapshot snapshot;
+    std::vector<BlockType> denseSnapshot(static_cast<size_t>(ChunkSnapshot::s_Size) * ChunkSnapshot::s_Height * ChunkSnapshot::s_Size, BlockType::VOID);
+
+    double paletteCapture = 0.0;
+    double denseCapture = 0.0;
+    double meshing = 0.0;
+    size_t meshed = 0;
+
+    for(int round = 0; round < s_Rounds; round++) {
+        for(int z = 1; z < s_GridSize - 1; z++) {
+            for(int x = 1; x < s_GridSize - 1; x++) {
+                std::array<std::shared_ptr<Chunk>, 9> neighbors;
+                std::array<const DenseChunk*, 9> denseNeighbors;
+
+                for(int dz = -1; dz <= 1; dz++) {
+                    for(int dx = -1; dx <= 1; dx++) {
+                        size_t index = static_cast<size_t>(z + dz) * s_GridSize + (x + dx);
+
+                        neighbors[(dz + 1) * 3 + (dx + 1)] = chunks[index];
+                        denseNeighbors[(dz + 1) * 3 + (dx + 1)] = &denseChunks[index];
+                    }
+                }
+
+                auto start = std::chrono::steady_clock::now();
+                snapshot.Capture(neighbors);
+                paletteCapture += GetSeconds(start);
+
+                start = std::chrono::steady_clock::now();
+                CaptureDense(denseNeighbors, denseSnapshot);
+                denseCapture += GetSeconds(start);
+
+                // both copies have to hold the same blocks for the comparison to mean anything
+                for(int y = 0; y < Chunk::s_ChunkHeight && round == 0; y += 7) {
+                    for(int i = 0; i < Chunk::s_ChunkSize; i++) {
+                        size_t index = (static_cast<size_t>(y + 1) * ChunkSnapshot::s_Size + (i + 1)) * ChunkSnapshot::s_Size + (i + 1);
+
+                        if(snapshot.Get(i, y, i) != denseSnapshot[index]) {
+                            std::cerr << "Dense and palette snapshots differ at " << i << ", " << y << ", " << i << std::endl;
+                            return 1;
+                        }
+                    }
+                }
+
+                Chunk& chunk = *chunks[static_cast<size_t>(z) * s_GridSize + x];
+
+                start = std::chrono::steady_clock::now();
+                chunk.BuildMesh(snapshot, MeshingMode::GREEDY);
+                meshing += GetSeconds(start);
+
+                meshed++;
+            }
+        }
+    }
+
+    std::println("snapshot capture: palette {:.3f} ms, dense {:.3f} ms, greedy meshing {:.3f} ms per chunk",
+                 paletteCapture * 1000.0 / meshed, denseCapture * 1000.0 / meshed, meshing * 1000.0 / meshed);
+    std::println("chunks meshed per second: palette {:.0f}, dense {:.0f}",
+                 meshed / (paletteCapture + meshing), meshed / (denseCapture + meshing));
+
+    return 0;
+}
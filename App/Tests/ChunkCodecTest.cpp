@@ -0,0 +1,231 @@
+#include "Chunk.h"
+#include "ChunkCodec.h"
+#include "BlockRegistry.h"
+#include "WorldGenerator.h"
+
+#include <array>
+#include <chrono>
+#include <print>
+#include <string.h>
+#include <iostream>
+
+// Round trips chunk sections through ChunkCodec with and without deflate,
+// decodes version 1 data, and feeds truncated and corrupted data to the
+// decoder, which has to reject it or decode it to known block types. Ends
+// with the encode and decode throughput and the compression ratio on
+// generated terrain, measured against one byte per block.
+
+using Sections = std::vector<BlockStorage>;
+
+static const uint32_t s_Seed = 1234567890;
+static const size_t s_SectionSize = Chunk::s_ChunkSize * Chunk::s_ChunkSize * Chunk::s_ChunkSize;
+
+static const int s_TerrainChunks = 32;
+static const int s_CorruptionsPerChunk = 64;
+static const int s_BenchmarkRounds = 20;
+
+static Sections CreateSections() {
+    return Sections(Chunk::s_SectionCount, BlockStorage(s_SectionSize));
+}
+
+static bool Equal(const Sections& a, const Sections& b) {
+    for(size_t section = 0; section < a.size(); section++) {
+        for(size_t i = 0; i < s_SectionSize; i++) {
+            if(a[section].Get(i) != b[section].Get(i)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// damaged data may still decode, but only to types the registry knows
+static bool Known(const Sections& sections) {
+    for(const auto& section : sections) {
+        for(size_t i = 0; i < s_SectionSize; i++) {
+            if(section.Get(i) >= std::size(BlockRegistry::s_Blocks)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// version 1 layout: bits per block, palette size minus one, palette, then the packed index words
+static std::vector<uint8_t> EncodeVersion1(const Sections& sections) {
+    std::vector<uint8_t> data = { 1 };
+    std::vector<uint8_t> indices(s_SectionSize);
+
+    for(const auto& section : sections) {
+        int bitsPerBlock = section.GetBitsPerBlock();
+        const std::vector<BlockType>& palette = section.GetPalette();
+
+        data.push_back(static_cast<uint8_t>(bitsPerBlock));
+        data.push_back(static_cast<uint8_t>(palette.size() - 1));
+        data.insert(data.end(), palette.begin(), palette.end());
+
+        if(bitsPerBlock == 0) {
+            continue;
+        }
+
+        section.GetIndices(indices.data());
+
+        std::vector<uint64_t> words((s_SectionSize * bitsPerBlock + 63) / 64, 0);
+
+        for(size_t i = 0; i < s_SectionSize; i++) {
+            size_t bit = i * bitsPerBlock;
+            words[bit >> 6] |= static_cast<uint64_t>(indices[i]) << (bit & 63);
+        }
+
+        size_t offset = data.size();
+        data.resize(offset + words.size() * sizeof(uint64_t));
+        memcpy(data.data() + offset, words.data(), words.size() * sizeof(uint64_t));
+    }
+
+    return data;
+}
+
+static bool Fail(const char* message, int chunk) {
+    std::cerr << message << " (chunk " << chunk << ")" << std::endl;
+    return false;
+}
+
+static bool TestChunk(const Sections& sections, int chunk, uint32_t& random) {
+    Sections decoded = CreateSections();
+
+    for(bool compress : { false, true }) {
+        if(compress && !ChunkCodec::s_CompressionAvailable) {
+            continue;
+        }
+
+        std::vector<uint8_t> data;
+        ChunkCodec::Encode(sections, data, compress);
+
+        if(!ChunkCodec::Decode(data.data(), data.size(), decoded) || !Equal(sections, decoded)) {
+            return Fail(compress ? "Deflated round trip failed" : "Round trip failed", chunk);
+        }
+
+        for(size_t size : { size_t(0), size_t(1), size_t(2), data.size() / 2, data.size() - 1 }) {
+            if(ChunkCodec::Decode(data.data(), size, decoded)) {
+                return Fail("Truncated data was decoded", chunk);
+            }
+        }
+
+        // the version byte is left alone, another version is a different format
+        for(int i = 0; i < s_CorruptionsPerChunk; i++) {
+            std::vector<uint8_t> damaged = data;
+
+            random = random * 1664525u + 1013904223u;
+            damaged[1 + (random >> 8) % (damaged.size() - 1)] ^= static_cast<uint8_t>(1u << (random & 7));
+
+            if(ChunkCodec::Decode(damaged.data(), damaged.size(), decoded) && !Known(decoded)) {
+                return Fail("Corrupted data decoded to unknown block types", chunk);
+            }
+        }
+    }
+
+    std::vector<uint8_t> version1 = EncodeVersion1(sections);
+
+    if(!ChunkCodec::Decode(version1.data(), version1.size(), decoded) || !Equal(sections, decoded)) {
+        return Fail("Version 1 data did not decode", chunk);
+    }
+
+    return true;
+}
+
+static void Benchmark(const std::vector<Sections>& chunks, bool compress) {
+    size_t rawSize = chunks.size() * Chunk::s_SectionCount * s_SectionSize;
+    size_t encodedSize = 0;
+
+    std::vector<std::vector<uint8_t>> encoded(chunks.size());
+    Sections decoded = CreateSections();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(int round = 0; round < s_BenchmarkRounds; round++) {
+        for(size_t i = 0; i < chunks.size(); i++) {
+            encoded[i].clear();
+            ChunkCodec::Encode(chunks[i], encoded[i], compress);
+        }
+    }
+
+    auto encodeEnd = std::chrono::steady_clock::now();
+
+    for(int round = 0; round < s_BenchmarkRounds; round++) {
+        for(const auto& data : encoded) {
+            ChunkCodec::Decode(data.data(), data.size(), decoded);
+        }
+    }
+
+    auto decodeEnd = std::chrono::steady_clock::now();
+
+    for(const auto& data : encoded) {
+        encodedSize += data.size();
+    }
+
+    double megabytes = static_cast<double>(rawSize) * s_BenchmarkRounds / 1e6;
+
+    std::println("{}: encode {:.0f} MB/s, decode {:.0f} MB/s, {} bytes per chunk, ratio {:.1f}x",
+                 compress ? "runs + deflate" : "runs",
+                 megabytes / std::chrono::duration<double>(encodeEnd - start).count(),
+                 megabytes / std::chrono::duration<double>(decodeEnd - encodeEnd).count(),
+                 encodedSize / chunks.size(),
+                 static_cast<double>(rawSize) / encodedSize);
+}
+
+int main() {
+    WorldGenerator generator(s_Seed);
+
+    std::vector<Sections> chunks;
+
+    for(int i = 0; i < s_TerrainChunks; i++) {
+        Chunk chunk(nullptr, glm::ivec2(i * 7 - 100, i * 3 - 50), nullptr, nullptr);
+        chunk.SetPosition({ (i * 7 - 100) * Chunk::s_ChunkSize, 0, (i * 3 - 50) * Chunk::s_ChunkSize });
+        chunk.Generate(generator);
+        chunk.GenerateDecorations(generator);
+
+        Sections sections;
+
+        for(int section = 0; section < Chunk::s_SectionCount; section++) {
+            sections.push_back(chunk.GetSection(section));
+        }
+
+        chunks.push_back(std::move(sections));
+    }
+
+    // worst cases for runs: every block differs from its neighbors, and a checkered layer
+    Sections noise = CreateSections();
+    Sections checkered = chunks[0];
+
+    for(auto& section : noise) {
+        for(size_t i = 0; i < s_SectionSize; i++) {
+            section.Set(i, static_cast<BlockType>((i * 7 + i / 16 * 3) % 11 + 1));
+        }
+    }
+
+    for(size_t i = 0; i < 256; i++) {
+        checkered[2].Set(i, (i + i / 16) % 2 ? BlockType::GLASS : BlockType::WOOD);
+    }
+
+    uint32_t random = 1;
+
+    for(int i = 0; i < s_TerrainChunks; i++) {
+        if(!TestChunk(chunks[i], i, random)) {
+            return 1;
+        }
+    }
+
+    if(!TestChunk(noise, -1, random) || !TestChunk(checkered, -2, random)) {
+        return 1;
+    }
+
+    Benchmark(chunks, false);
+
+    if(ChunkCodec::s_CompressionAvailable) {
+        Benchmark(chunks, true);
+    }
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include "Chunk.h"
+#include "ChunkJobPool.h"
+#include "ChunkManager.h"
+#include "ChunkSnapshot.h"
+#include "WorldGenerator.h"
+
+#include <array>
+#include <chrono>
+#include <print>
+#include <thread>
+#include <iostream>
+
+// Meshes the same batch of chunks through ChunkJobPool with 1, 2, 4 and so
+// on up to one worker per hardware thread, and reports the chunks meshed per
+// second for every worker count. Snapshots are captured up front, so the
+// workers only mesh, like MESH jobs do.
+
+static const uint32_t s_Seed = 1234567890;
+
+// generated grid, every chunk but the border ones gets a snapshot
+static const int s_GridSize = 7;
+
+// every job meshes its own chunk, so no two workers write the same staging buffers
+static const size_t s_JobsPerRound = 256;
+static const int s_Rounds = 4;
+
+static std::vector<std::shared_ptr<ChunkSnapshot>> CreateSnapshots(WorldGenerator& generator) {
+    std::vector<std::shared_ptr<Chunk>> chunks;
+
+    for(int z = 0; z < s_GridSize; z++) {
+        for(int x = 0; x < s_GridSize; x++) {
+            auto chunk = std::make_shared<Chunk>(nullptr, glm::ivec2(x, z), nullptr, nullptr);
+            chunk->SetPosition({ x * Chunk::s_ChunkSize, 0, z * Chunk::s_ChunkSize });
+            chunk->Generate(generator);
+
+            chunks.push_back(chunk);
+        }
+    }
+
+    for(auto& chunk : chunks) {
+        chunk->GenerateDecorations(generator);
+    }
+
+    std::vector<std::shared_ptr<ChunkSnapshot>> snapshots;
+
+    for(int z = 1; z < s_GridSize - 1; z++) {
+        for(int x = 1; x < s_GridSize - 1; x++) {
+            std::array<std::shared_ptr<Chunk>, 9> neighbors;
+
+            for(int dz = -1; dz <= 1; dz++) {
+                for(int dx = -1; dx <= 1; dx++) {
+                    neighbors[(dz + 1) * 3 + (dx + 1)] = chunks[static_cast<size_t>(z + dz) * s_GridSize + (x + dx)];
+                }
+            }
+
+            auto snapshot = std::make_shared<ChunkSnapshot>();
+            snapshot->Capture(neighbors);
+
+            snapshots.push_back(snapshot);
+        }
+    }
+
+    return snapshots;
+}
+
+// chunks meshed per second with the given number of workers
+static double Benchmark(size_t workerCount, const std::vector<ChunkJob>& jobs) {
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t completed = 0;
+    size_t target = 0;
+
+    // the pool moves the jobs out, every round pushes a fresh copy
+    std::vector<ChunkJob> batch;
+
+    ChunkJobPool pool(workerCount, [&](ChunkJob& job) {
+        job.Chunk->BuildMesh(*job.Snapshot, MeshingMode::GREEDY);
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if(++completed == target) {
+            done.notify_one();
+        }
+    });
+
+    auto Round = [&]() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            target += jobs.size();
+        }
+
+        batch.assign(jobs.begin(), jobs.end());
+        pool.Push(batch);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return completed == target; });
+    };
+
+    // first round grows the staging buffers of every chunk
+    Round();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(int round = 0; round < s_Rounds; round++) {
+        Round();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return static_cast<double>(jobs.size()) * s_Rounds / seconds;
+}
+
+int main() {
+    WorldGenerator generator(s_Seed);
+
+    std::vector<std::shared_ptr<ChunkSnapshot>> snapshots = CreateSnapshots(generator);
+    std::vector<ChunkJob> jobs;
+
+    for(size_t i = 0; i < s_JobsPerRound; i++) {
+        ChunkJob job = { ChunkJobType::MESH, std::make_shared<Chunk>(nullptr, glm::ivec2(0, 0), nullptr, nullptr) };
+        job.Snapshot = snapshots[i % snapshots.size()];
+        job.Priority = static_cast<float>(i);
+
+        jobs.push_back(std::move(job));
+    }
+
+    size_t maxWorkers = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    std::vector<size_t> workerCounts;
+
+    for(size_t workers = 1; workers < maxWorkers; workers *= 2) {
+        workerCounts.push_back(workers);
+    }
+
+    workerCounts.push_back(maxWorkers);
+
+    double single = 0.0;
+
+    for(size_t workers : workerCounts) {
+        double rate = Benchmark(workers, jobs);
+
+        if(workers == 1) {
+            single = rate;
+        }
+
+        std::println("{} workers: {:.0f} chunks meshed/s, {:.2f}x one worker", workers, rate, rate / single);
+    }
+
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include "Chunk.h"
+#include "MPSCQueue.h"
+#include "ChunkJobPool.h"
+#include "ChunkManager.h"
+#include "ChunkSnapshot.h"
+#include "ChunkSnapshotPool.h"
+#include "WorldGenerator.h"
+
+#include <new>
+#include <array>
+#include <print>
+#include <atomic>
+#include <thread>
+#include <stdlib.h>
+#include <iostream>
+
+// Meshes a chunk again and again into the same staging buffers and checks
+// that, once the buffers have grown to fit the mesh, building it does not
+// touch the heap. Then runs mesh jobs the way ChunkManager does: snapshots
+// taken from the pool on dispatch, meshed and returned by the workers, and
+// chunks drained from the meshed queue, which must not allocate either once
+// the pools are warm. Every operator new of the process is counted here.
+
+static std::atomic<size_t> s_Allocations = 0;
+
+void* operator new(size_t size) {
+    s_Allocations++;
+
+    if(void* memory = malloc(size ? size : 1)) {
+        return memory;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+static const uint32_t s_Seed = 1234567890;
+
+// builds before counting, the staging buffers reach their final capacity on the first one
+static const int s_WarmupBuilds = 2;
+static const int s_CountedBuilds = 10;
+
+static const size_t s_Workers = 2;
+static const int s_WarmupDispatches = 4;
+static const int s_CountedDispatches = 20;
+
+// dispatches MESH jobs for every chunk, the workers mesh them and the main thread drains the meshed queue
+static bool TestPipeline(const std::array<std::shared_ptr<Chunk>, 9>& chunks) {
+    ChunkSnapshotPool snapshotPool(chunks.size());
+    MPSCQueue<std::shared_ptr<Chunk>> meshedChunks;
+    std::atomic<size_t> meshed = 0;
+
+    ChunkJobPool jobPool(s_Workers, [&](ChunkJob& job) {
+        job.Chunk->BuildMesh(*job.Snapshot, MeshingMode::GREEDY);
+        snapshotPool.Release(std::move(job.Snapshot));
+
+        meshedChunks.Push(job.Chunk);
+        meshed++;
+    });
+
+    std::vector<ChunkJob> jobs;
+    jobs.reserve(chunks.size());
+
+    size_t allocations = 0;
+
+    for(int dispatch = 0; dispatch < s_WarmupDispatches + s_CountedDispatches; dispatch++) {
+        if(dispatch == s_WarmupDispatches) {
+            allocations = s_Allocations;
+        }
+
+        jobs.clear();
+
+        for(const auto& chunk : chunks) {
+            ChunkJob job = { ChunkJobType::MESH, chunk };
+            job.Snapshot = snapshotPool.Acquire();
+            job.Snapshot->Capture(chunks);
+
+            jobs.push_back(std::move(job));
+        }
+
+        // the jobs are moved to the workers, so the worker meshing a snapshot holds its last reference
+        jobPool.Push(jobs);
+
+        // warmup drains only full batches, so the meshed queue grows every node a batch can need
+        while(dispatch < s_WarmupDispatches && meshed < (dispatch + 1) * chunks.size()) {
+            std::this_thread::yield();
+        }
+
+        size_t drained = 0;
+        std::shared_ptr<Chunk> chunk;
+
+        while(drained < chunks.size()) {
+            if(meshedChunks.Pop(chunk)) {
+                drained++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    allocations = s_Allocations - allocations;
+
+    if(allocations != 0) {
+        std::cerr << "Dispatching, meshing and draining made " << allocations << " allocations in " << s_CountedDispatches << " dispatches" << std::endl;
+        return false;
+    }
+
+    std::println("mesh jobs: no allocations in {} dispatches of {} chunks", s_CountedDispatches, chunks.size());
+    return true;
+}
+
+int main() {
+    WorldGenerator generator(s_Seed);
+
+    std::array<std::shared_ptr<Chunk>, 9> chunks;
+
+    for(int z = -1; z <= 1; z++) {
+        for(int x = -1; x <= 1; x++) {
+            auto chunk = std::make_shared<Chunk>(nullptr, glm::ivec2(x, z), nullptr, nullptr);
+            chunk->SetPosition({ x * Chunk::s_ChunkSize, 0, z * Chunk::s_ChunkSize });
+            chunk->Generate(generator);
+
+            chunks[(z + 1) * 3 + (x + 1)] = chunk;
+        }
+    }
+
+    for(auto& chunk : chunks) {
+        chunk->GenerateDecorations(generator);
+    }
+
+    Chunk& chunk = *chunks[4];
+
+    ChunkSnapshot snapshot;
+    snapshot.Capture(chunks);
+
+    chunk.SetMeshStaging(std::make_unique<ChunkMeshStaging>());
+
+    const MeshingMode modes[2] = { MeshingMode::NAIVE, MeshingMode::GREEDY };
+
+    for(MeshingMode mode : modes) {
+        const char* name = mode == MeshingMode::GREEDY ? "greedy" : "naive";
+
+        for(int i = 0; i < s_WarmupBuilds; i++) {
+            chunk.BuildMesh(snapshot, mode);
+        }
+
+        size_t allocations = s_Allocations;
+
+        for(int i = 0; i < s_CountedBuilds; i++) {
+            chunk.BuildMesh(snapshot, mode);
+        }
+
+        allocations = s_Allocations - allocations;
+
+        if(allocations != 0) {
+            std::cerr << "The " << name << " mesher made " << allocations << " allocations in " << s_CountedBuilds << " chunk meshes" << std::endl;
+            return 1;
+        }
+
+        std::println("{} mesher: no allocations in {} chunk meshes", name, s_CountedBuilds);
+    }
+
+    for(auto& neighbor : chunks) {
+        if(!neighbor->HasMeshStaging()) {
+            neighbor->SetMeshStaging(std::make_unique<ChunkMeshStaging>());
+        }
+    }
+
+    if(!TestPipeline(chunks)) {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include "Chunk.h"
+#include "ChunkSnapshot.h"
+#include "WorldGenerator.h"
+
+#include <set>
+#include <array>
+#include <tuple>
+#include <print>
+#include <climits>
+#include <iostream>
+
+// Meshes the same chunk with the naive and the greedy mesher and checks that
+// both cover exactly the same block faces with the same atlas tiles. Merged
+// quads must also repeat their tile once per block rather than stretch it.
+
+// normal, plane along the normal, the two coordinates within the plane, tile x, tile y
+using Cell = std::tuple<int, int, int, int, int, int>;
+
+static const uint32_t s_Seed = 1234567890;
+
+// splits every quad into the block faces it covers, false if a quad's texture coordinates do not match its size
+static bool Rasterize(const std::vector<Renderer::ChunkVertex>& vertices, std::multiset<Cell>& cells) {
+    for(size_t quad = 0; quad + 3 < vertices.size(); quad += 4) {
+        glm::ivec3 min(INT_MAX);
+        glm::ivec3 max(INT_MIN);
+
+        int maxU = 0;
+        int maxV = 0;
+
+        for(size_t i = quad; i < quad + 4; i++) {
+            uint32_t position = vertices[i].Data[0];
+            uint32_t texture = vertices[i].Data[1];
+
+            glm::ivec3 corner(position & 31, (position >> 5) & 511, (position >> 14) & 31);
+
+            min = glm::min(min, corner);
+            max = glm::max(max, corner);
+
+            maxU = std::max(maxU, static_cast<int>((texture >> 8) & 31));
+            maxV = std::max(maxV, static_cast<int>((texture >> 13) & 31));
+        }
+
+        uint32_t position = vertices[quad].Data[0];
+        uint32_t texture = vertices[quad].Data[1];
+
+        int normal = static_cast<int>((position >> 19) & 7);
+        int tileX = static_cast<int>(texture & 15);
+        int tileY = static_cast<int>((texture >> 4) & 15);
+
+        // the quad is flat along one axis
+        int axis = min.x == max.x ? 0 : (min.y == max.y ? 1 : 2);
+        int a = (axis + 1) % 3;
+        int b = (axis + 2) % 3;
+
+        if(maxU * maxV != (max[a] - min[a]) * (max[b] - min[b])) {
+            return false;
+        }
+
+        for(int i = min[a]; i < max[a]; i++) {
+            for(int j = min[b]; j < max[b]; j++) {
+                cells.insert({ normal, min[axis], i, j, tileX, tileY });
+            }
+        }
+    }
+
+    return true;
+}
+
+int main() {
+    WorldGenerator generator(s_Seed);
+
+    // the chunk in the middle and its neighbors, indexed like ChunkSnapshot::Capture expects
+    std::array<std::shared_ptr<Chunk>, 9> chunks;
+
+    for(int z = -1; z <= 1; z++) {
+        for(int x = -1; x <= 1; x++) {
+            auto chunk = std::make_shared<Chunk>(nullptr, glm::ivec2(x, z), nullptr, nullptr);
+            chunk->SetPosition({ x * Chunk::s_ChunkSize, 0, z * Chunk::s_ChunkSize });
+            chunk->Generate(generator);
+
+            chunks[(z + 1) * 3 + (x + 1)] = chunk;
+        }
+    }
+
+    for(auto& chunk : chunks) {
+        chunk->GenerateDecorations(generator);
+    }
+
+    // holes and glass give the faces varied neighbors, ambient occlusion and translucent quads
+    Chunk& chunk = *chunks[4];
+
+    for(int i = 0; i < 30; i++) {
+        chunk.SetBlockType(glm::vec3(i % 16, 40 + i % 7, (i * 7) % 16), BlockType::AIR);
+    }
+
+    for(int i = 0; i < 8; i++) {
+        chunk.SetBlockType(glm::vec3(4 + i % 4, 120, 4 + i / 4), BlockType::GLASS);
+    }
+
+    ChunkSnapshot snapshot;
+    snapshot.Capture(chunks);
+
+    const MeshingMode modes[2] = { MeshingMode::NAIVE, MeshingMode::GREEDY };
+    std::multiset<Cell> coverage[2];
+
+    for(int mode = 0; mode < 2; mode++) {
+        chunk.BuildMesh(snapshot, modes[mode]);
+
+        const ChunkMeshStaging* staging = chunk.GetMeshStaging();
+
+        for(int section = 0; section < Chunk::s_SectionCount; section++) {
+            if(!Rasterize(staging->Opaque[section].Vertices, coverage[mode]) ||
+               !Rasterize(staging->Translucent[section].Vertices, coverage[mode])) {
+                std::cerr << (mode == 0 ? "Naive" : "Greedy") << " quad texture coordinates do not match its size in section " << section << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    if(coverage[0].empty()) {
+        std::cerr << "Chunk mesh is empty" << std::endl;
+        return 1;
+    }
+
+    if(coverage[0] != coverage[1]) {
+        std::cerr << "Naive mesh covers " << coverage[0].size() << " faces, greedy mesh covers " << coverage[1].size() << std::endl;
+        return 1;
+    }
+
+    std::println("{} block faces covered the same by the naive and the greedy mesher", coverage[0].size());
+
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include "Chunk.h"
+#include "ChunkStore.h"
+
+#include <mutex>
+#include <chrono>
+#include <print>
+#include <iostream>
+#include <unordered_map>
+
+// Compares the toroidal ChunkStore against the mutex-guarded unordered_map
+// it replaced. Fills both with the chunks of the default view distance around
+// a camera away from the origin, then times the 3x3 neighborhood lookups
+// every snapshot makes, lookups of chunks just out of range, and iterating
+// all chunks.
+
+// the hash and the locking of the map ChunkManager used before
+struct ChunkMapHash {
+    size_t operator()(const glm::ivec2& v) const noexcept {
+        uint64_t x = static_cast<uint32_t>(v.x);
+        uint64_t y = static_cast<uint32_t>(v.y);
+
+        return std::hash<uint64_t>()(x * 73856093ull ^ y * 73856093ull);
+    }
+};
+
+using ChunkMap = std::unordered_map<glm::ivec2, std::shared_ptr<Chunk>, ChunkMapHash>;
+
+// view distance plus the remove distance, as AppLayer creates its ChunkManager
+static const int s_Radius = 14;
+static const int s_ViewDistance = 12;
+
+// negative coordinates on one axis, so the slot mask wraps
+static const glm::ivec2 s_Center = glm::ivec2(1000, -300);
+
+static const int s_Rounds = 200;
+
+static double GetNanoseconds(std::chrono::steady_clock::time_point start, size_t count) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+}
+
+int main() {
+    ChunkStore store(s_Radius);
+    ChunkMap map;
+    std::mutex mapMutex;
+
+    std::vector<glm::ivec2> positions;
+
+    for(int z = -s_ViewDistance; z <= s_ViewDistance; z++) {
+        for(int x = -s_ViewDistance; x <= s_ViewDistance; x++) {
+            glm::ivec2 position = s_Center + glm::ivec2(x, z);
+            auto chunk = std::make_shared<Chunk>(nullptr, position, nullptr, nullptr);
+
+            store.Insert(chunk);
+            map[position] = chunk;
+
+            positions.push_back(position);
+        }
+    }
+
+    if(store.GetCount() != map.size()) {
+        std::cerr << "Store holds " << store.GetCount() << " chunks, the map " << map.size() << std::endl;
+        return 1;
+    }
+
+    // the ring just outside the view distance, none of these are loaded
+    std::vector<glm::ivec2> misses;
+
+    for(int i = -s_ViewDistance - 1; i <= s_ViewDistance + 1; i++) {
+        misses.push_back(s_Center + glm::ivec2(i, -s_ViewDistance - 1));
+        misses.push_back(s_Center + glm::ivec2(i, s_ViewDistance + 1));
+        misses.push_back(s_Center + glm::ivec2(-s_ViewDistance - 1, i));
+        misses.push_back(s_Center + glm::ivec2(s_ViewDistance + 1, i));
+    }
+
+    // lookups that hit, a chunk and its 8 neighbors clamped to the loaded square
+    std::vector<glm::ivec2> hits;
+
+    for(glm::ivec2 position : positions) {
+        for(int z = -1; z <= 1; z++) {
+            for(int x = -1; x <= 1; x++) {
+                hits.push_back(glm::clamp(position + glm::ivec2(x, z), s_Center - s_ViewDistance, s_Center + s_ViewDistance));
+            }
+        }
+    }
+
+    // results are summed, so neither loop can be optimized away and both have to agree
+    size_t storeSum = 0;
+    size_t mapSum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(int round = 0; round < s_Rounds; round++) {
+        for(glm::ivec2 position : hits) {
+            storeSum += store.Get(position) != nullptr;
+        }
+    }
+
+    double storeHit = GetNanoseconds(start, hits.size() * s_Rounds);
+
+    start = std::chrono::steady_clock::now();
+
+    for(int round = 0; round < s_Rounds; round++) {
+        for(glm::ivec2 position : hits) {
+            std::lock_guard<std::mutex> lock(mapMutex);
+            mapSum += map.find(position) != map.end();
+        }
+    }
+
+    double mapHit = GetNanoseconds(start, hits.size() * s_Rounds);
+
+    start = std::chrono::steady_clock::now();
+
+    for(int round = 0; round < s_Rounds; round++) {
+        for(glm::ivec2 position : misses) {
+            storeSum += store.Contains(position);
+        }
+    }
+
+    double storeMiss = GetNanoseconds(start, misses.size() * s_Rounds);
+
+    start = std::chrono::steady_clock::now();
+
+    for(int round = 0; round < s_Rounds; round++) {
+        for(glm::ivec2 position : misses) {
+            std::lock_guard<std::mutex> lock(mapMutex);
+            mapSum += map.contains(position);
+        }
+    }
+
+    double mapMiss = GetNanoseconds(start, misses.size() * s_Rounds);
+
+    start = std::chrono::steady_clock::now();
+
+    for(int round = 0; round < s_Rounds; round++) {
+        for(const auto& chunk : store) {
+            storeSum += static_cast<size_t>(chunk->GetKey().x);
+        }
+    }
+
+    double storeIteration = GetNanoseconds(start, store.GetCount() * s_Rounds);
+
+    start = std::chrono::steady_clock::now();
+
+    for(int round = 0; round < s_Rounds; round++) {
+        std::lock_guard<std::mutex> lock(mapMutex);
+
+        for(const auto& [position, chunk] : map) {
+            mapSum += static_cast<size_t>(chunk->GetKey().x);
+        }
+    }
+
+    double mapIteration = GetNanoseconds(start, map.size() * s_Rounds);
+
+    if(storeSum != mapSum) {
+        std::cerr << "Store and map disagree on the chunks they hold" << std::endl;
+        return 1;
+    }
+
+    std::println("{} chunks, ns per lookup: hit store {:.1f} map {:.1f}, miss store {:.1f} map {:.1f}",
+                 store.GetCount(), storeHit, mapHit, storeMiss, mapMiss);
+    std::println("ns per chunk iterated: store {:.2f} map {:.2f}", storeIteration, mapIteration);
+
+    return 0;
+}
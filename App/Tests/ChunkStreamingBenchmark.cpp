@@ -0,0 +1,164 @@
+#include "Chunk.h"
+#include "WorldStorage.h"
+#include "WorldGenerator.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <print>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+
+#if defined(__linux__)
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// Measures how long saved chunks take to come back while the player flies
+// over a world that was saved before. Saves a strip of chunks, then flies a
+// fixed path along it one chunk per frame and submits the column entering the
+// view distance each frame, like a dispatch picks the saved chunks in front
+// of the camera. The time from submitting a read to its completion is
+// recorded for every chunk, and the percentiles are printed for the pread and
+// the io_uring backends. Every chunk has to come back as it was saved.
+
+static const uint32_t s_Seed = 1234567890;
+static const int s_ViewDistance = 12;
+static const int s_PathLength = 64;
+
+// the saved chunks repeat a few generated ones, generating the whole strip would take longer than flying it
+static const int s_TemplateSize = 4;
+
+static const std::chrono::microseconds s_FrameTime(16667);
+
+static double GetMilliseconds(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// a world opened after a reboot is not in the page cache, on Linux the region files are dropped from it
+static void DropPageCache(const std::filesystem::path& directory) {
+#if defined(__linux__)
+    for(const auto& entry : std::filesystem::directory_iterator(directory)) {
+        int file = open(entry.path().c_str(), O_RDONLY);
+
+        if(file < 0) {
+            continue;
+        }
+
+        fdatasync(file);
+        posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+        close(file);
+    }
+#endif
+}
+
+static size_t GetTemplate(glm::ivec2 chunk) {
+    return (chunk.x & (s_TemplateSize - 1)) + (chunk.y & (s_TemplateSize - 1)) * s_TemplateSize;
+}
+
+// false when a chunk did not come back as it was saved
+static bool Fly(const std::filesystem::path& directory, IOBackendType backend, const std::vector<std::vector<uint8_t>>& templates) {
+    DropPageCache(directory);
+
+    std::vector<std::chrono::steady_clock::duration> latencies;
+    std::atomic<size_t> mismatches = 0;
+
+    std::chrono::steady_clock::duration flightTime;
+    const char* name = nullptr;
+
+    {
+        WorldStorage storage(directory, backend);
+        name = storage.GetBackendName();
+
+        size_t columnSize = 2 * s_ViewDistance + 1;
+        latencies.resize(s_PathLength * columnSize);
+
+        auto start = std::chrono::steady_clock::now();
+
+        for(int step = 0; step < s_PathLength; step++) {
+            std::this_thread::sleep_until(start + step * s_FrameTime);
+
+            // the column entering the view distance in front of the camera
+            std::vector<ChunkRead> reads;
+
+            for(int z = -s_ViewDistance; z <= s_ViewDistance; z++) {
+                reads.push_back({ glm::ivec2(step + s_ViewDistance, z) });
+            }
+
+            size_t first = step * columnSize;
+            auto submitted = std::chrono::steady_clock::now();
+
+            storage.Load(std::move(reads), [&, first, submitted](size_t index, ChunkRead& read) {
+                latencies[first + index] = std::chrono::steady_clock::now() - submitted;
+
+                if(!read.Found || read.Data != templates[GetTemplate(read.Chunk)]) {
+                    mismatches++;
+                }
+            });
+        }
+
+        storage.WaitForLoads();
+        flightTime = std::chrono::steady_clock::now() - start;
+    }
+
+    if(mismatches != 0) {
+        std::cerr << name << ": " << mismatches << " of " << latencies.size() << " chunks did not load back as they were saved" << std::endl;
+        return false;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    auto percentile = [&](double p) {
+        return GetMilliseconds(latencies[static_cast<size_t>(p * (latencies.size() - 1))]);
+    };
+
+    std::println("{}: {} chunks over {} frames, load latency p50 {:.3f} ms, p90 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms, flight {:.1f} ms",
+                 name, latencies.size(), s_PathLength, percentile(0.5), percentile(0.9), percentile(0.99), percentile(1.0), GetMilliseconds(flightTime));
+
+    return true;
+}
+
+int main() {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "CraftmineStreamingBenchmark";
+    std::filesystem::remove_all(directory);
+
+    WorldGenerator generator(s_Seed);
+
+    std::vector<std::vector<uint8_t>> templates(s_TemplateSize * s_TemplateSize);
+
+    for(int z = 0; z < s_TemplateSize; z++) {
+        for(int x = 0; x < s_TemplateSize; x++) {
+            glm::ivec2 position(x, z);
+
+            auto chunk = std::make_shared<Chunk>(nullptr, position, nullptr, nullptr);
+            chunk->SetPosition({ position.x * Chunk::s_ChunkSize, 0, position.y * Chunk::s_ChunkSize });
+            chunk->Generate(generator);
+            chunk->GenerateDecorations(generator);
+
+            chunk->Serialize(templates[GetTemplate(position)]);
+        }
+    }
+
+    {
+        WorldStorage storage(directory);
+
+        for(int x = s_ViewDistance; x < s_PathLength + s_ViewDistance; x++) {
+            for(int z = -s_ViewDistance; z <= s_ViewDistance; z++) {
+                storage.Save(glm::ivec2(x, z), templates[GetTemplate(glm::ivec2(x, z))]);
+            }
+        }
+
+        if(!storage.FlushAll()) {
+            std::cerr << "Failed to write the region files" << std::endl;
+            return 1;
+        }
+    }
+
+    // io_uring falls back to pread where it is not available, the backend name tells which one ran
+    bool loaded = Fly(directory, IOBackendType::POSITIONAL, templates) && Fly(directory, IOBackendType::URING, templates);
+
+    std::filesystem::remove_all(directory);
+
+    return loaded ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+#include "Chunk.h"
+#include "WorldStorage.h"
+#include "WorldGenerator.h"
+
+#include <chrono>
+#include <print>
+#include <iostream>
+#include <filesystem>
+
+#if defined(__linux__)
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// Compares the two ways a chunk comes back when a world is opened again:
+// generated and decorated from noise, or read from the region files and
+// decoded. Saves every chunk within the default view distance, then times
+// regenerating them against loading them through a freshly opened
+// WorldStorage, in batches like the LOAD jobs read them. The loaded blocks
+// have to match the generated ones.
+
+static const uint32_t s_Seed = 1234567890;
+static const int s_ViewDistance = 12;
+
+// saved chunks one dispatch picks at most, two jobs for each of 8 workers
+static const size_t s_BatchSize = 16;
+
+static double GetMilliseconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// a world opened after a reboot is not in the page cache, on Linux the region files are dropped from it
+static void DropPageCache(const std::filesystem::path& directory) {
+#if defined(__linux__)
+    for(const auto& entry : std::filesystem::directory_iterator(directory)) {
+        int file = open(entry.path().c_str(), O_RDONLY);
+
+        if(file < 0) {
+            continue;
+        }
+
+        fdatasync(file);
+        posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+        close(file);
+    }
+#endif
+}
+
+int main() {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "CraftmineStartupBenchmark";
+    std::filesystem::remove_all(directory);
+
+    WorldGenerator generator(s_Seed);
+
+    std::vector<glm::ivec2> positions;
+
+    for(int z = -s_ViewDistance; z <= s_ViewDistance; z++) {
+        for(int x = -s_ViewDistance; x <= s_ViewDistance; x++) {
+            positions.push_back(glm::ivec2(x, z));
+        }
+    }
+
+    // regeneration is what opening a world costs without region files
+    std::vector<std::shared_ptr<Chunk>> chunks;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(glm::ivec2 position : positions) {
+        auto chunk = std::make_shared<Chunk>(nullptr, position, nullptr, nullptr);
+        chunk->SetPosition({ position.x * Chunk::s_ChunkSize, 0, position.y * Chunk::s_ChunkSize });
+        chunk->Generate(generator);
+        chunk->GenerateDecorations(generator);
+
+        chunks.push_back(chunk);
+    }
+
+    double generateTime = GetMilliseconds(start);
+
+    std::vector<std::vector<uint8_t>> generated(positions.size());
+
+    for(size_t i = 0; i < positions.size(); i++) {
+        chunks[i]->Serialize(generated[i]);
+    }
+
+    {
+        WorldStorage storage(directory);
+
+        for(size_t i = 0; i < positions.size(); i++) {
+            storage.Save(positions[i], generated[i]);
+        }
+
+        if(!storage.FlushAll()) {
+            std::cerr << "Failed to write the region files" << std::endl;
+            return 1;
+        }
+    }
+
+    DropPageCache(directory);
+
+    std::vector<std::shared_ptr<Chunk>> loaded(positions.size());
+
+    start = std::chrono::steady_clock::now();
+
+    {
+        WorldStorage storage(directory);
+
+        for(size_t first = 0; first < positions.size(); first += s_BatchSize) {
+            size_t last = std::min(first + s_BatchSize, positions.size());
+
+            std::vector<ChunkRead> reads;
+
+            for(size_t i = first; i < last; i++) {
+                reads.push_back({ positions[i] });
+            }
+
+            storage.Load(reads);
+
+            for(size_t i = first; i < last; i++) {
+                const ChunkRead& read = reads[i - first];
+
+                auto chunk = std::make_shared<Chunk>(nullptr, positions[i], nullptr, nullptr);
+
+                if(read.Found && chunk->Deserialize(read.Data.data(), read.Data.size())) {
+                    loaded[i] = chunk;
+                }
+            }
+        }
+    }
+
+    double loadTime = GetMilliseconds(start);
+
+    // encoding is deterministic, equal data means equal blocks
+    size_t mismatches = 0;
+
+    for(size_t i = 0; i < positions.size(); i++) {
+        std::vector<uint8_t> data;
+
+        if(loaded[i]) {
+            loaded[i]->Serialize(data);
+        }
+
+        mismatches += data != generated[i];
+    }
+
+    std::filesystem::remove_all(directory);
+
+    if(mismatches != 0) {
+        std::cerr << mismatches << " of " << positions.size() << " chunks did not load back as they were saved" << std::endl;
+        return 1;
+    }
+
+    std::println("{} chunks: generate {:.1f} ms, load from region files {:.1f} ms ({:.1f}x faster)",
+                 positions.size(), generateTime, loadTime, generateTime / loadTime);
+
+    return 0;
+}
@@ -60,6 +60,132 @@ namespace Core {
         float m_Time = 0.0f;
     };
 
+    class ChunksMemoryUpdatedEvent : public Event {
+    public:
+        ChunksMemoryUpdatedEvent(int chunks, size_t bytes)
+            : m_Chunks(chunks), m_Bytes(bytes) {}
+
+        inline int GetChunks() const { return m_Chunks; }
+        inline size_t GetBytes() const { return m_Bytes; }
+
+        std::string ToString() const override {
+            return std::format("ChunksMemoryUpdatedEvent: {} chunks use {} bytes", m_Chunks, m_Bytes);
+        }
+
+        EVENT_CLASS_TYPE(ChunksMemoryUpdated)
+    private:
+        int m_Chunks = 0;
+        size_t m_Bytes = 0;
+    };
+
+    class ChunkJobsUpdatedEvent : public Event {
+    public:
+        ChunkJobsUpdatedEvent(int workers, float chunksMeshedPerSecond, int jobsScheduled, int jobsCancelled)
+            : m_Workers(workers), m_ChunksMeshedPerSecond(chunksMeshedPerSecond), m_JobsScheduled(jobsScheduled), m_JobsCancelled(jobsCancelled) {}
+
+        inline int GetWorkers() const { return m_Workers; }
+        inline float GetChunksMeshedPerSecond() const { return m_ChunksMeshedPerSecond; }
+        inline int GetJobsScheduled() const { return m_JobsScheduled; }
+        inline int GetJobsCancelled() const { return m_JobsCancelled; }
+
+        std::string ToString() const override {
+            return std::format("ChunkJobsUpdatedEvent: {} workers mesh {} chunks per second, {} jobs scheduled, {} cancelled", m_Workers, m_ChunksMeshedPerSecond, m_JobsScheduled, m_JobsCancelled);
+        }
+
+        EVENT_CLASS_TYPE(ChunkJobsUpdated)
+    private:
+        int m_Workers = 0;
+        float m_ChunksMeshedPerSecond = 0.0f;
+        int m_JobsScheduled = 0;
+        int m_JobsCancelled = 0;
+    };
+
+    class ChunkUploadsUpdatedEvent : public Event {
+    public:
+        ChunkUploadsUpdatedEvent(int uploaded, int deferred, size_t bytes, float time)
+            : m_Uploaded(uploaded), m_Deferred(deferred), m_Bytes(bytes), m_Time(time) {}
+
+        inline int GetUploaded() const { return m_Uploaded; }
+        inline int GetDeferred() const { return m_Deferred; }
+        inline size_t GetBytes() const { return m_Bytes; }
+        inline float GetTime() const { return m_Time; }
+
+        std::string ToString() const override {
+            return std::format("ChunkUploadsUpdatedEvent: {} chunks ({} bytes) uploaded in {} seconds, {} deferred", m_Uploaded, m_Bytes, m_Time, m_Deferred);
+        }
+
+        EVENT_CLASS_TYPE(ChunkUploadsUpdated)
+    private:
+        int m_Uploaded = 0;
+        int m_Deferred = 0;
+        size_t m_Bytes = 0;
+        float m_Time = 0.0f;
+    };
+
+    class ChunkPoolUpdatedEvent : public Event {
+    public:
+        ChunkPoolUpdatedEvent(int pooled, size_t hits, size_t misses)
+            : m_Pooled(pooled), m_Hits(hits), m_Misses(misses) {}
+
+        inline int GetPooled() const { return m_Pooled; }
+        inline size_t GetHits() const { return m_Hits; }
+        inline size_t GetMisses() const { return m_Misses; }
+
+        std::string ToString() const override {
+            return std::format("ChunkPoolUpdatedEvent: {} chunks pooled, {} hits, {} misses", m_Pooled, m_Hits, m_Misses);
+        }
+
+        EVENT_CLASS_TYPE(ChunkPoolUpdated)
+    private:
+        int m_Pooled = 0;
+        size_t m_Hits = 0;
+        size_t m_Misses = 0;
+    };
+
+    class ChunkCacheUpdatedEvent : public Event {
+    public:
+        ChunkCacheUpdatedEvent(int cached, size_t bytes, size_t hits, size_t misses)
+            : m_Cached(cached), m_Bytes(bytes), m_Hits(hits), m_Misses(misses) {}
+
+        inline int GetCached() const { return m_Cached; }
+        inline size_t GetBytes() const { return m_Bytes; }
+        inline size_t GetHits() const { return m_Hits; }
+        inline size_t GetMisses() const { return m_Misses; }
+
+        std::string ToString() const override {
+            return std::format("ChunkCacheUpdatedEvent: {} chunks ({} bytes) cached, {} hits, {} misses", m_Cached, m_Bytes, m_Hits, m_Misses);
+        }
+
+        EVENT_CLASS_TYPE(ChunkCacheUpdated)
+    private:
+        int m_Cached = 0;
+        size_t m_Bytes = 0;
+        size_t m_Hits = 0;
+        size_t m_Misses = 0;
+    };
+
+    class WorldLoadedEvent : public Event {
+    public:
+        WorldLoadedEvent(float time, int chunksLoaded, int chunksGenerated, const std::string& ioBackend)
+            : m_Time(time), m_ChunksLoaded(chunksLoaded), m_ChunksGenerated(chunksGenerated), m_IOBackend(ioBackend) {}
+
+        inline float GetTime() const { return m_Time; }
+        inline int GetChunksLoaded() const { return m_ChunksLoaded; }
+        inline int GetChunksGenerated() const { return m_ChunksGenerated; }
+        inline const std::string& GetIOBackend() const { return m_IOBackend; }
+
+        std::string ToString() const override {
+            return std::format("WorldLoadedEvent: view distance loaded in {} seconds, {} chunks read with {}, {} generated", m_Time, m_ChunksLoaded, m_IOBackend, m_ChunksGenerated);
+        }
+
+        EVENT_CLASS_TYPE(WorldLoaded)
+    private:
+        float m_Time = 0.0f;
+        int m_ChunksLoaded = 0;
+        int m_ChunksGenerated = 0;
+        std::string m_IOBackend;
+    };
+
     class SelectedItemUpdatedEvent : public Event {
     public:
         SelectedItemUpdatedEvent(int item)
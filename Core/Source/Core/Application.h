@@ -25,10 +25,10 @@ namespace Core {
 
         void RaiseEvent(Event& event);
 
-        template<typename TLayer>
+        template<typename TLayer, typename... Args>
         requires(std::is_base_of_v<Layer, TLayer>)
-        void PushLayer() {
-            m_LayerStack.push_back(std::make_unique<TLayer>());
+        void PushLayer(Args&&... args) {
+            m_LayerStack.push_back(std::make_unique<TLayer>(std::forward<Args>(args)...));
         }
 
         template<typename TLayer>
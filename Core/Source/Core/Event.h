@@ -10,7 +10,7 @@ namespace Core {
         WindowClose, WindowResize,
         KeyPressed, KeyReleased,
         MouseButtonPressed, MouseButtonReleased, MouseMoved, MouseScrolled,
-        PositionUpdated, TimeUpdated, ChunksGenerated, SelectedItemUpdated
+        PositionUpdated, TimeUpdated, ChunksGenerated, ChunksMemoryUpdated, ChunkJobsUpdated, ChunkUploadsUpdated, ChunkPoolUpdated, ChunkCacheUpdated, WorldLoaded, SelectedItemUpdated
     };
 
 #define EVENT_CLASS_TYPE(type) static EventType GetStaticType() { return EventType::type; }\
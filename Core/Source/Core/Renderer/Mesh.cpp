@@ -1,4 +1,5 @@
 #include "Mesh.h"
+#include "QuadIndexBuffer.h"
 
 #include <glad/gl.h>
 
@@ -14,19 +15,7 @@ namespace Renderer {
 
     void Mesh::Build(const std::vector<Vertex>& vertices, 
                      const std::vector<uint32_t>& indices) {
-        // create arrays and buffers
-        glCreateVertexArrays(1, &m_VertexArray);
-        glCreateBuffers(1, &m_VertexBufferVertices);
-        //glCreateBuffers(1, &m_VertexBufferUVs);
-        glCreateBuffers(1, &m_ElementBuffer);
-
-        // TODO: change the VAO creation to upload vertex
-        glNamedBufferData(m_VertexBufferVertices, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
-        // glNamedBufferData(m_VertexBufferUVs, uvs.size() * sizeof(glm::vec2), &uvs.front(), GL_STATIC_DRAW);
-        glNamedBufferData(m_ElementBuffer, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
-
-        // bind vertices
-        glVertexArrayVertexBuffer(m_VertexArray, 0, m_VertexBufferVertices, 0, sizeof(Vertex));
+        CreateBuffers(vertices.data(), sizeof(Vertex), vertices.size());
 
         // position attribute (location = 0)
         glEnableVertexArrayAttrib(m_VertexArray, 0);
@@ -52,15 +41,58 @@ namespace Renderer {
         glVertexArrayAttribFormat(m_VertexArray, 3, 1, GL_UNSIGNED_BYTE, GL_FALSE, offsetof(Vertex, AO));
         glVertexArrayAttribBinding(m_VertexArray, 3, 0);
 
+        glCreateBuffers(1, &m_ElementBuffer);
+        glNamedBufferData(m_ElementBuffer, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+
         // bind the element buffer to the vertex array
         glVertexArrayElementBuffer(m_VertexArray, m_ElementBuffer);
 
+        m_IndexCount = static_cast<int>(indices.size());
+
         // create uniform buffer
         // glCreateBuffers(1, &m_UniformBuffer);
         // glNamedBufferData(m_UniformBuffer, sizeof(glm::mat4) * 2, nullptr, GL_DYNAMIC_DRAW);
         // glBindBufferBase(GL_UNIFORM_BUFFER, 0, m_UniformBuffer);
+    }
 
-        m_IndexCount = static_cast<int>(indices.size());
+    void Mesh::Build(const std::vector<ChunkVertex>& vertices) {
+        size_t quadCount = vertices.size() / QuadIndexBuffer::s_VerticesPerQuad;
+
+        if(m_VertexArray == 0) {
+            // nothing to draw, objects are created with the first non-empty mesh
+            if(vertices.empty()) {
+                return;
+            }
+
+            CreateBuffers(vertices.data(), sizeof(ChunkVertex), vertices.size());
+
+            // packed vertex data (location = 0), read as integers and unpacked in the shader
+            glEnableVertexArrayAttrib(m_VertexArray, 0);
+            glVertexArrayAttribIFormat(m_VertexArray, 0, 2, GL_UNSIGNED_INT, offsetof(ChunkVertex, Data));
+            glVertexArrayAttribBinding(m_VertexArray, 0, 0);
+        } else {
+            // new storage under the same buffer name, the vertex array keeps pointing to it
+            glNamedBufferData(m_VertexBufferVertices, vertices.size() * sizeof(ChunkVertex), vertices.data(), GL_STATIC_DRAW);
+        }
+
+        // the shared buffer is not owned by the mesh, m_ElementBuffer stays empty so Reset leaves it alone
+        glVertexArrayElementBuffer(m_VertexArray, QuadIndexBuffer::Get(quadCount));
+
+        m_IndexCount = static_cast<int>(quadCount * QuadIndexBuffer::s_IndicesPerQuad);
+    }
+
+    void Mesh::CreateBuffers(const void* vertices, size_t vertexSize, size_t vertexCount) {
+        // create arrays and buffers
+        glCreateVertexArrays(1, &m_VertexArray);
+        glCreateBuffers(1, &m_VertexBufferVertices);
+        //glCreateBuffers(1, &m_VertexBufferUVs);
+
+        // TODO: change the VAO creation to upload vertex
+        glNamedBufferData(m_VertexBufferVertices, vertexCount * vertexSize, vertices, GL_STATIC_DRAW);
+        // glNamedBufferData(m_VertexBufferUVs, uvs.size() * sizeof(glm::vec2), &uvs.front(), GL_STATIC_DRAW);
+
+        // bind vertices
+        glVertexArrayVertexBuffer(m_VertexArray, 0, m_VertexBufferVertices, 0, static_cast<GLsizei>(vertexSize));
     }
 
     void Mesh::Bind() {
@@ -68,11 +100,32 @@ namespace Renderer {
     }
 
     void Mesh::Reset() {
+        // nothing was ever built, so meshes that stayed on the CPU can be destroyed without a GL context
+        if(m_VertexArray == 0 && m_VertexBufferVertices == 0 && m_ElementBuffer == 0) {
+            m_IndexCount = 0;
+            return;
+        }
+
         glDeleteVertexArrays(1, &m_VertexArray);
         glDeleteBuffers(1, &m_VertexBufferVertices);
         //glDeleteBuffers(1, &m_VertexBufferUVs);
         glDeleteBuffers(1, &m_ElementBuffer);
         // glDeleteBuffers(1, &m_UniformBuffer);
+
+        // names can be reused by new objects, so they must not be deleted twice
+        m_VertexArray = 0;
+        m_VertexBufferVertices = 0;
+        m_ElementBuffer = 0;
+
+        m_IndexCount = 0;
+    }
+
+    void Mesh::Clear() {
+        if(m_VertexBufferVertices != 0) {
+            glNamedBufferData(m_VertexBufferVertices, 0, nullptr, GL_STATIC_DRAW);
+        }
+
+        m_IndexCount = 0;
     }
 
     int Mesh::GetIndexCount() {
@@ -15,11 +15,20 @@ namespace Renderer {
 
         void Build(const std::vector<Vertex>& vertices,
                    const std::vector<uint32_t>& indices);
+        // quads of 4 vertices each, drawn with the shared quad index buffer;
+        // the vertex array and buffer are created once and refilled by later builds
+        void Build(const std::vector<ChunkVertex>& vertices);
         void Bind();
         void Reset();
 
+        // releases the vertex data but keeps the objects for the next Build
+        void Clear();
+
         int GetIndexCount();
 
+    private:
+        void CreateBuffers(const void* vertices, size_t vertexSize, size_t vertexCount);
+
     private:
         uint32_t m_VertexArray = 0;
         uint32_t m_VertexBufferVertices = 0;
@@ -0,0 +1,50 @@
+#include "QuadIndexBuffer.h"
+
+#include <glad/gl.h>
+
+#include <vector>
+
+namespace Renderer {
+
+    uint32_t QuadIndexBuffer::s_Handle = 0;
+    size_t QuadIndexBuffer::s_QuadCount = 0;
+
+    uint32_t QuadIndexBuffer::Get(size_t quadCount) {
+        if(s_Handle == 0) {
+            glCreateBuffers(1, &s_Handle);
+        }
+
+        if(quadCount <= s_QuadCount) {
+            return s_Handle;
+        }
+
+        // grow in powers of two, so a few resizes cover the largest mesh
+        size_t newQuadCount = s_QuadCount > 0 ? s_QuadCount : 1024;
+
+        while(newQuadCount < quadCount) {
+            newQuadCount *= 2;
+        }
+
+        std::vector<uint32_t> indices;
+        indices.reserve(newQuadCount * s_IndicesPerQuad);
+
+        for(size_t quad = 0; quad < newQuadCount; quad++) {
+            uint32_t offset = static_cast<uint32_t>(quad * s_VerticesPerQuad);
+
+            indices.push_back(offset + 0);
+            indices.push_back(offset + 1);
+            indices.push_back(offset + 2);
+            indices.push_back(offset + 2);
+            indices.push_back(offset + 3);
+            indices.push_back(offset + 0);
+        }
+
+        // respecifying the data keeps the buffer name, vertex arrays pointing to it see the new storage
+        glNamedBufferData(s_Handle, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+
+        s_QuadCount = newQuadCount;
+
+        return s_Handle;
+    }
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Renderer {
+
+    // Element buffer holding the indices of consecutive quads (0, 1, 2, 2, 3, 0, 4, 5, 6, ...),
+    // shared by every mesh drawn as a list of quads. It grows on demand and keeps its name,
+    // so vertex arrays built against a smaller buffer stay valid.
+    class QuadIndexBuffer {
+    public:
+        // returns the buffer, grown to fit at least quadCount quads
+        static uint32_t Get(size_t quadCount);
+
+        static const size_t s_IndicesPerQuad = 6;
+        static const size_t s_VerticesPerQuad = 4;
+    private:
+        static uint32_t s_Handle;
+        static size_t s_QuadCount;
+    };
+
+}
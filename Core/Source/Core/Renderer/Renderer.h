@@ -2,6 +2,8 @@
 
 #include <glm/glm.hpp>
 
+#include <stdint.h>
+
 namespace Renderer {
 
     struct Vertex {
@@ -11,4 +13,21 @@ namespace Renderer {
         uint8_t AO;
     };
 
-}
\ No newline at end of file
+    // Chunk mesh vertex packed into two integers, unpacked in ChunkVertex.glsl:
+    //   x: position x (5 bits), y (9 bits), z (5 bits), normal index (3 bits), ambient occlusion (2 bits)
+    //   y: atlas tile column (4 bits), row (4 bits), uv u (5 bits), v (5 bits)
+    // Positions are block corners relative to the chunk, so they are whole numbers.
+    struct ChunkVertex {
+        uint32_t Data[2] = { 0, 0 };
+
+        static ChunkVertex Pack(glm::ivec3 position, uint32_t normal, uint32_t ao, glm::ivec2 tile, glm::ivec2 uv) {
+            ChunkVertex vertex;
+
+            vertex.Data[0] = (position.x & 31u) | (position.y & 511u) << 5 | (position.z & 31u) << 14 | (normal & 7u) << 19 | (ao & 3u) << 22;
+            vertex.Data[1] = (tile.x & 15u) | (tile.y & 15u) << 4 | (uv.x & 31u) << 8 | (uv.y & 31u) << 13;
+
+            return vertex;
+        }
+    };
+
+}
@@ -44,6 +44,11 @@ namespace Renderer {
         glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
     }
 
+    void Shader::SetVec2(const char* key, const glm::vec2& value) const {
+        uint32_t location = glGetUniformLocation(m_Handle, key);
+        glUniform2fv(location, 1, glm::value_ptr(value));
+    }
+
     void Shader:: SetVec3(const char* key, const glm::vec3& value) const {
         uint32_t location = glGetUniformLocation(m_Handle, key);
         glUniform3fv(location, 1, glm::value_ptr(value));
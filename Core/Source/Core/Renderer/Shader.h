@@ -18,6 +18,7 @@ namespace Renderer {
         void SetBool(const char* key, const bool& value) const;
         void SetFloat(const char* key, const float& value) const;
         void SetMat4(const char* key, const glm::mat4& value) const;
+        void SetVec2(const char* key, const glm::vec2& value) const;
         void SetVec3(const char* key, const glm::vec3& value) const;
 
     private:
@@ -13,7 +13,7 @@ namespace Renderer {
 
     }
 
-    std::vector<glm::vec2> TextureAtlas::GetTileUV(int x, int y) const {
+    std::array<glm::vec2, 4> TextureAtlas::GetTileUV(int x, int y) const {
         float tileW = 1.0f / m_Width;
         float tileH = 1.0f / m_Height;
 
@@ -23,16 +23,24 @@ namespace Renderer {
         float UMax = UMin + tileW;
         float VMax = VMin + tileH;
 
-        std::vector<glm::vec2> uvs = {
+        std::array<glm::vec2, 4> uvs = {{
             { UMin, VMax },
             { UMax, VMax },
             { UMax, VMin },
             { UMin, VMin }
-        };
+        }};
 
         return uvs;
     }
 
+    glm::vec2 TextureAtlas::GetTileOrigin(int x, int y) const {
+        return glm::vec2(x, y) * GetTileSize();
+    }
+
+    glm::vec2 TextureAtlas::GetTileSize() const {
+        return { 1.0f / m_Width, 1.0f / m_Height };
+    }
+
     std::shared_ptr<Texture> TextureAtlas::GetTexture() {
         return m_Texture;
     }
@@ -4,6 +4,7 @@
 
 #include <glm/glm.hpp>
 
+#include <array>
 #include <memory>
 #include <vector>
 #include <filesystem>
@@ -15,7 +16,9 @@ namespace Renderer {
         TextureAtlas(const std::filesystem::path& path, int width, int height);
         ~TextureAtlas();
 
-        std::vector<glm::vec2> GetTileUV(int x, int y) const;
+        std::array<glm::vec2, 4> GetTileUV(int x, int y) const;
+        glm::vec2 GetTileOrigin(int x, int y) const;
+        glm::vec2 GetTileSize() const;
         std::shared_ptr<Texture> GetTexture();
 
     private:
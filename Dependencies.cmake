@@ -70,3 +70,14 @@ if(NOT freetype_FOUND)
         add_subdirectory(${freetype_SOURCE_DIR} ${freetype_BINARY_DIR})
     endif()
 endif()
+
+# liburing (optional, Linux only), chunk I/O falls back to pread and pwrite without it
+if(CMAKE_SYSTEM_NAME STREQUAL "Linux")
+    find_package(PkgConfig QUIET)
+    if(PkgConfig_FOUND)
+        pkg_check_modules(liburing QUIET IMPORTED_TARGET liburing)
+    endif()
+endif()
+
+# zlib (optional), saved chunks are stored without the deflate stage when it is missing
+find_package(ZLIB QUIET)